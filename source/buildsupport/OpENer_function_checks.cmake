@@ -3,6 +3,7 @@
 ########################################
 
 include (CheckFunctionExists)
+include (CheckSymbolExists)
 
 check_function_exists( srand HAVE_SRAND )
 check_function_exists( rand HAVE_RAND )
@@ -10,3 +11,20 @@ check_function_exists( rand HAVE_RAND )
 if( (NOT(HAVE_SRAND)) OR (NOT(HAVE_RAND)) )
   
 endif( (NOT(HAVE_SRAND)) OR (NOT(HAVE_RAND)) )
+
+# Batched datagram receive and send for the implicit I/O sockets
+set( CMAKE_REQUIRED_DEFINITIONS -D_GNU_SOURCE )
+check_symbol_exists( recvmmsg "sys/socket.h" HAVE_RECVMMSG )
+check_symbol_exists( sendmmsg "sys/socket.h" HAVE_SENDMMSG )
+# Accepting TCP connections as non-blocking sockets with one call
+check_symbol_exists( accept4 "sys/socket.h" HAVE_ACCEPT4 )
+unset( CMAKE_REQUIRED_DEFINITIONS )
+if( HAVE_RECVMMSG )
+  add_definitions( -DOPENER_HAVE_RECVMMSG )
+endif( HAVE_RECVMMSG )
+if( HAVE_SENDMMSG )
+  add_definitions( -DOPENER_HAVE_SENDMMSG )
+endif( HAVE_SENDMMSG )
+if( HAVE_ACCEPT4 )
+  add_definitions( -DOPENER_HAVE_ACCEPT4 )
+endif( HAVE_ACCEPT4 )
@@ -20,6 +20,7 @@ typedef struct {
   unsigned int output_assembly; /**< the O-to-T point for the connection */
   unsigned int input_assembly; /**< the T-to-O point for the connection */
   unsigned int config_assembly; /**< the config point for the connection */
+  CipUint production_phase; /**< phase of the productions, see ConfigureProductionPhase() */
   CipConnectionObject connection_data; /**< the connection data, only one connection is allowed per O-to-T point*/
 } ExclusiveOwnerConnection;
 
@@ -28,8 +29,8 @@ typedef struct {
   unsigned int output_assembly; /**< the O-to-T point for the connection */
   unsigned int input_assembly; /**< the T-to-O point for the connection */
   unsigned int config_assembly; /**< the config point for the connection */
-  CipConnectionObject connection_data[
-    OPENER_CIP_NUM_INPUT_ONLY_CONNS_PER_CON_PATH];                                   /*< the connection data */
+  CipUint production_phase; /**< phase of the productions, see ConfigureProductionPhase() */
+  CipConnectionObject *connection_data; /**< the connections of the connection point */
 } InputOnlyConnection;
 
 /** @brief Listen Only connection data */
@@ -37,17 +38,21 @@ typedef struct {
   unsigned int output_assembly; /**< the O-to-T point for the connection */
   unsigned int input_assembly; /**< the T-to-O point for the connection */
   unsigned int config_assembly; /**< the config point for the connection */
-  CipConnectionObject connection_data[
-    OPENER_CIP_NUM_LISTEN_ONLY_CONNS_PER_CON_PATH
-  ];                                                                               /**< the connection data */
+  CipUint production_phase; /**< phase of the productions, see ConfigureProductionPhase() */
+  CipConnectionObject *connection_data; /**< the connections of the connection point */
 } ListenOnlyConnection;
 
-ExclusiveOwnerConnection g_exlusive_owner_connections[
-  OPENER_CIP_NUM_EXLUSIVE_OWNER_CONNS];                                                     /**< Exclusive Owner connections */
+ExclusiveOwnerConnection *g_exlusive_owner_connections = NULL; /**< Exclusive Owner connections */
 
-InputOnlyConnection g_input_only_connections[OPENER_CIP_NUM_INPUT_ONLY_CONNS]; /**< Input Only connections */
+InputOnlyConnection *g_input_only_connections = NULL; /**< Input Only connections */
 
-ListenOnlyConnection g_listen_only_connections[OPENER_CIP_NUM_LISTEN_ONLY_CONNS]; /**< Listen Only connections */
+ListenOnlyConnection *g_listen_only_connections = NULL; /**< Listen Only connections */
+
+/** @brief Storage of the connections of the input only connection points */
+static CipConnectionObject *s_input_only_connection_data = NULL;
+
+/** @brief Storage of the connections of the listen only connection points */
+static CipConnectionObject *s_listen_only_connection_data = NULL;
 
 /** @brief Takes an ConnectionObject and searches and returns an Exclusive Owner Connection based on the ConnectionObject,
  * if there is non it returns NULL
@@ -87,7 +92,8 @@ void ConfigureExclusiveOwnerConnectionPoint(
   const unsigned int output_assembly,
   const unsigned int input_assembly,
   const unsigned int config_assembly) {
-  if (OPENER_CIP_NUM_EXLUSIVE_OWNER_CONNS > connection_number) {
+  if (GetConnectionCapacity()->exclusive_owner_connection_points >
+      connection_number) {
     g_exlusive_owner_connections[connection_number].output_assembly =
       output_assembly;
     g_exlusive_owner_connections[connection_number].input_assembly =
@@ -101,7 +107,8 @@ void ConfigureInputOnlyConnectionPoint(const unsigned int connection_number,
                                        const unsigned int output_assembly,
                                        const unsigned int input_assembly,
                                        const unsigned int config_assembly) {
-  if (OPENER_CIP_NUM_INPUT_ONLY_CONNS > connection_number) {
+  if (GetConnectionCapacity()->input_only_connection_points >
+      connection_number) {
     g_input_only_connections[connection_number].output_assembly =
       output_assembly;
     g_input_only_connections[connection_number].input_assembly = input_assembly;
@@ -114,7 +121,8 @@ void ConfigureListenOnlyConnectionPoint(const unsigned int connection_number,
                                         const unsigned int output_assembly,
                                         const unsigned int input_assembly,
                                         const unsigned int config_assembly) {
-  if (OPENER_CIP_NUM_LISTEN_ONLY_CONNS > connection_number) {
+  if (GetConnectionCapacity()->listen_only_connection_points >
+      connection_number) {
     g_listen_only_connections[connection_number].output_assembly =
       output_assembly;
     g_listen_only_connections[connection_number].input_assembly =
@@ -124,6 +132,55 @@ void ConfigureListenOnlyConnectionPoint(const unsigned int connection_number,
   }
 }
 
+EipStatus ConfigureProductionPhase(const unsigned int input_assembly_id,
+                                   const CipUint phase) {
+  if (kProductionPhaseResolution <= phase &&
+      kProductionPhaseAutomatic != phase) {
+    return kEipStatusError;
+  }
+  const ConnectionCapacity *const capacity = GetConnectionCapacity();
+  EipStatus status = kEipStatusError;
+  for (size_t i = 0; i < capacity->exclusive_owner_connection_points; ++i) {
+    if (input_assembly_id == g_exlusive_owner_connections[i].input_assembly) {
+      g_exlusive_owner_connections[i].production_phase = phase;
+      status = kEipStatusOk;
+    }
+  }
+  for (size_t i = 0; i < capacity->input_only_connection_points; ++i) {
+    if (input_assembly_id == g_input_only_connections[i].input_assembly) {
+      g_input_only_connections[i].production_phase = phase;
+      status = kEipStatusOk;
+    }
+  }
+  for (size_t i = 0; i < capacity->listen_only_connection_points; ++i) {
+    if (input_assembly_id == g_listen_only_connections[i].input_assembly) {
+      g_listen_only_connections[i].production_phase = phase;
+      status = kEipStatusOk;
+    }
+  }
+  return status;
+}
+
+CipUint GetProductionPhase(const unsigned int input_assembly_id) {
+  const ConnectionCapacity *const capacity = GetConnectionCapacity();
+  for (size_t i = 0; i < capacity->exclusive_owner_connection_points; ++i) {
+    if (input_assembly_id == g_exlusive_owner_connections[i].input_assembly) {
+      return g_exlusive_owner_connections[i].production_phase;
+    }
+  }
+  for (size_t i = 0; i < capacity->input_only_connection_points; ++i) {
+    if (input_assembly_id == g_input_only_connections[i].input_assembly) {
+      return g_input_only_connections[i].production_phase;
+    }
+  }
+  for (size_t i = 0; i < capacity->listen_only_connection_points; ++i) {
+    if (input_assembly_id == g_listen_only_connections[i].input_assembly) {
+      return g_listen_only_connections[i].production_phase;
+    }
+  }
+  return kProductionPhaseAutomatic;
+}
+
 CipConnectionObject *GetIoConnectionForConnectionData(
   CipConnectionObject *const RESTRICT connection_object,
   EipUint16 *const extended_error) {
@@ -179,7 +236,8 @@ CipConnectionObject *GetExclusiveOwnerConnection(
   const CipConnectionObject *const RESTRICT connection_object,
   EipUint16 *const extended_error) {
 
-  for (size_t i = 0; i < OPENER_CIP_NUM_EXLUSIVE_OWNER_CONNS; ++i) {
+  const ConnectionCapacity *const capacity = GetConnectionCapacity();
+  for (size_t i = 0; i < capacity->exclusive_owner_connection_points; ++i) {
     if ( (g_exlusive_owner_connections[i].output_assembly ==
           connection_object->consumed_path.instance_id)
          && (g_exlusive_owner_connections[i].input_assembly ==
@@ -226,8 +284,9 @@ CipConnectionObject *GetInputOnlyConnection(
   const CipConnectionObject *const RESTRICT connection_object,
   EipUint16 *const extended_error) {
   EipUint16 err = 0;
+  const ConnectionCapacity *const capacity = GetConnectionCapacity();
 
-  for (size_t i = 0; i < OPENER_CIP_NUM_INPUT_ONLY_CONNS; ++i) {
+  for (size_t i = 0; i < capacity->input_only_connection_points; ++i) {
     if (g_input_only_connections[i].output_assembly
         == connection_object->consumed_path.instance_id) { /* we have the same output assembly */
       if (g_input_only_connections[i].input_assembly
@@ -241,7 +300,7 @@ CipConnectionObject *GetInputOnlyConnection(
         continue;
       }
 
-      for (size_t j = 0; j < OPENER_CIP_NUM_INPUT_ONLY_CONNS_PER_CON_PATH;
+      for (size_t j = 0; j < capacity->input_only_connections_per_point;
            ++j) {
         if (kConnectionObjectStateTimedOut
             == ConnectionObjectGetState(&(g_input_only_connections[i].
@@ -256,7 +315,7 @@ CipConnectionObject *GetInputOnlyConnection(
         }
       }
 
-      for (size_t j = 0; j < OPENER_CIP_NUM_INPUT_ONLY_CONNS_PER_CON_PATH;
+      for (size_t j = 0; j < capacity->input_only_connections_per_point;
            ++j) {
         if (kConnectionObjectStateNonExistent
             == ConnectionObjectGetState(&(g_input_only_connections[i].
@@ -277,8 +336,9 @@ CipConnectionObject *GetListenOnlyConnection(
   const CipConnectionObject *const RESTRICT connection_object,
   EipUint16 *const extended_error) {
   EipUint16 err = 0;
+  const ConnectionCapacity *const capacity = GetConnectionCapacity();
 
-  for (size_t i = 0; i < OPENER_CIP_NUM_LISTEN_ONLY_CONNS; i++) {
+  for (size_t i = 0; i < capacity->listen_only_connection_points; i++) {
     if (g_listen_only_connections[i].output_assembly
         == connection_object->consumed_path.instance_id) { /* we have the same output assembly */
       if (g_listen_only_connections[i].input_assembly
@@ -300,7 +360,7 @@ CipConnectionObject *GetListenOnlyConnection(
         break;
       }
 
-      for (size_t j = 0; j < OPENER_CIP_NUM_LISTEN_ONLY_CONNS_PER_CON_PATH;
+      for (size_t j = 0; j < capacity->listen_only_connections_per_point;
            ++j) {
         if (kConnectionObjectStateTimedOut
             == ConnectionObjectGetState(&(g_listen_only_connections[i].
@@ -315,7 +375,7 @@ CipConnectionObject *GetListenOnlyConnection(
         }
       }
 
-      for (size_t j = 0; j < OPENER_CIP_NUM_LISTEN_ONLY_CONNS_PER_CON_PATH;
+      for (size_t j = 0; j < capacity->listen_only_connections_per_point;
            j++) {
         if (kConnectionObjectStateNonExistent
             == ConnectionObjectGetState(&(g_listen_only_connections[i].
@@ -332,66 +392,64 @@ CipConnectionObject *GetListenOnlyConnection(
   return NULL;
 }
 
+/** @brief Accepts I/O connections managing the production of their input
+ * assembly, multicast producers only if the bool context is set */
+static bool IsProducerIoConnection(const void *const connection_object,
+                                   const void *const multicast_only) {
+  const CipConnectionObject *const connection = connection_object;
+  if (!ConnectionObjectIsTypeIOConnection(connection) ||
+      kEipInvalidSocket ==
+      connection->socket[kUdpCommuncationDirectionProducing]) {
+    return false;
+  }
+  const ConnectionObjectConnectionType connection_type =
+    ConnectionObjectGetTToOConnectionType(connection);
+  return kConnectionObjectConnectionTypeMulticast == connection_type ||
+         (!*(const bool *) multicast_only &&
+          kConnectionObjectConnectionTypePointToPoint == connection_type);
+}
+
 CipConnectionObject *GetExistingProducerIoConnection(
   const bool multicast_only,
   const EipUint32 input_point) {
-  const DoublyLinkedListNode *node = connection_list.first;
+  /* we look for a connection that produces the same input assembly,
+   * and manages the connection.
+   */
+  return GetConnectionProducingAssembly( (CipInstanceNum) input_point,
+                                         IsProducerIoConnection,
+                                         &multicast_only );
+}
 
-  while (NULL != node) {
-    CipConnectionObject *producer_io_connection = node->data;
-    if (ConnectionObjectIsTypeIOConnection(producer_io_connection) &&
-        (input_point == producer_io_connection->produced_path.instance_id) &&
-        (kEipInvalidSocket !=
-         producer_io_connection->socket[kUdpCommuncationDirectionProducing]) )
-    {
-      ConnectionObjectConnectionType cnxn_type =
-        ConnectionObjectGetTToOConnectionType(producer_io_connection);
-      /* we have a connection that produces the same input assembly,
-       * and manages the connection.
-       */
-      if (kConnectionObjectConnectionTypeMulticast == cnxn_type) {
-        return producer_io_connection;
-      }
-      if (!multicast_only &&
-          kConnectionObjectConnectionTypePointToPoint == cnxn_type)
-      {
-        return producer_io_connection;
-      }
-    }
-    node = node->next;
-  }
-  return NULL;
+/** @brief Accepts established multicast producers which do not manage the
+ * production of their input assembly */
+static bool IsNonControlMasterConnection(const void *const connection_object,
+                                         const void *const context) {
+  (void) context;
+  const CipConnectionObject *const connection = connection_object;
+  return ConnectionObjectIsTypeNonLOIOConnection(connection) &&
+         kConnectionObjectStateEstablished ==
+         ConnectionObjectGetState(connection) &&
+         kConnectionObjectConnectionTypeMulticast ==
+         ConnectionObjectGetTToOConnectionType(connection) &&
+         kEipInvalidSocket ==
+         connection->socket[kUdpCommuncationDirectionProducing];
 }
 
 CipConnectionObject *GetNextNonControlMasterConnection(
   const EipUint32 input_point) {
-  const DoublyLinkedListNode *node = connection_list.first;
+  return GetConnectionProducingAssembly( (CipInstanceNum) input_point,
+                                         IsNonControlMasterConnection,
+                                         NULL );
+}
 
-  while (NULL != node) {
-    CipConnectionObject *next_non_control_master_connection =
-      node->data;
-    if ( true ==
-         ConnectionObjectIsTypeNonLOIOConnection(
-           next_non_control_master_connection)
-         && kConnectionObjectStateEstablished ==
-         ConnectionObjectGetState(next_non_control_master_connection)
-         && input_point ==
-         next_non_control_master_connection->produced_path.instance_id
-         &&  kConnectionObjectConnectionTypeMulticast ==
-         ConnectionObjectGetTToOConnectionType(
-           next_non_control_master_connection)
-         && (kEipInvalidSocket ==
-             next_non_control_master_connection->socket[
-               kUdpCommuncationDirectionProducing
-             ]) ) {
-      /* we have a connection that produces the same input assembly,
-       * is a multicast producer and does not manage the connection.
-       */
-      return next_non_control_master_connection;
-    }
-    node = node->next;
-  }
-  return NULL;
+/** @brief Accepts connections of the instance type given as context which
+ * have not been closed yet */
+static bool IsOpenConnectionOfInstanceType(const void *const connection_object,
+                                           const void *const instance_type) {
+  return *(const ConnectionObjectInstanceType *) instance_type ==
+         ConnectionObjectGetInstanceType(connection_object) &&
+         kConnectionObjectStateNonExistent !=
+         ConnectionObjectGetState(connection_object);
 }
 
 void CloseAllConnectionsForInputWithSameType(const EipUint32 input_point,
@@ -400,21 +458,19 @@ void CloseAllConnectionsForInputWithSameType(const EipUint32 input_point,
 
   OPENER_TRACE_INFO("Close all instance type %d only connections\n",
                     instance_type);
-  const DoublyLinkedListNode *node = connection_list.first;
-  while (NULL != node) {
-    CipConnectionObject *const connection = node->data;
-    node = node->next;
-    if ( (instance_type == ConnectionObjectGetInstanceType(connection) )
-         && (input_point == connection->produced_path.instance_id) ) {
-      CipConnectionObject *connection_to_delete = connection;
-      CheckIoConnectionEvent(
-        connection_to_delete->consumed_path.instance_id,
-        connection_to_delete->produced_path.instance_id,
-        kIoConnectionEventClosed);
-
-      assert(connection_to_delete->connection_close_function != NULL);
-      connection_to_delete->connection_close_function(connection_to_delete);
-    }
+  /* closing removes the connection from the index of the produced assembly */
+  CipConnectionObject *connection_to_delete = NULL;
+  while ( NULL != ( connection_to_delete = GetConnectionProducingAssembly(
+                      (CipInstanceNum) input_point,
+                      IsOpenConnectionOfInstanceType,
+                      &instance_type) ) ) {
+    CheckIoConnectionEvent(
+      connection_to_delete->consumed_path.instance_id,
+      connection_to_delete->produced_path.instance_id,
+      kIoConnectionEventClosed);
+
+    assert(connection_to_delete->connection_close_function != NULL);
+    connection_to_delete->connection_close_function(connection_to_delete);
   }
 }
 
@@ -442,12 +498,76 @@ bool ConnectionWithSameConfigPointExists(const EipUint32 config_point) {
   return false;
 }
 
-void InitializeIoConnectionData(void) {
-  memset( g_exlusive_owner_connections, 0,
-          OPENER_CIP_NUM_EXLUSIVE_OWNER_CONNS *
-          sizeof(ExclusiveOwnerConnection) );
-  memset( g_input_only_connections, 0,
-          OPENER_CIP_NUM_INPUT_ONLY_CONNS * sizeof(InputOnlyConnection) );
-  memset( g_listen_only_connections, 0,
-          OPENER_CIP_NUM_LISTEN_ONLY_CONNS * sizeof(ListenOnlyConnection) );
+EipStatus InitializeIoConnectionData(void) {
+  const ConnectionCapacity *const capacity = GetConnectionCapacity();
+  const size_t number_of_input_only_connections =
+    capacity->input_only_connection_points *
+    capacity->input_only_connections_per_point;
+  const size_t number_of_listen_only_connections =
+    capacity->listen_only_connection_points *
+    capacity->listen_only_connections_per_point;
+
+  ShutdownIoConnectionData();
+  g_exlusive_owner_connections = CipCalloc(
+    capacity->exclusive_owner_connection_points,
+    sizeof(ExclusiveOwnerConnection) );
+  g_input_only_connections = CipCalloc(capacity->input_only_connection_points,
+                                       sizeof(InputOnlyConnection) );
+  s_input_only_connection_data = CipCalloc(number_of_input_only_connections,
+                                           sizeof(CipConnectionObject) );
+  g_listen_only_connections = CipCalloc(capacity->listen_only_connection_points,
+                                        sizeof(ListenOnlyConnection) );
+  s_listen_only_connection_data = CipCalloc(number_of_listen_only_connections,
+                                            sizeof(CipConnectionObject) );
+  if( (NULL == g_exlusive_owner_connections &&
+       0 != capacity->exclusive_owner_connection_points) ||
+      (NULL == g_input_only_connections &&
+       0 != capacity->input_only_connection_points) ||
+      (NULL == s_input_only_connection_data &&
+       0 != number_of_input_only_connections) ||
+      (NULL == g_listen_only_connections &&
+       0 != capacity->listen_only_connection_points) ||
+      (NULL == s_listen_only_connection_data &&
+       0 != number_of_listen_only_connections) ) {
+    OPENER_TRACE_ERR("Could not allocate the I/O connections\n");
+    ShutdownIoConnectionData();
+    return kEipStatusError;
+  }
+
+  for (size_t i = 0; i < capacity->exclusive_owner_connection_points; ++i) {
+    g_exlusive_owner_connections[i].production_phase =
+      kProductionPhaseAutomatic;
+  }
+  for (size_t i = 0; i < capacity->input_only_connection_points; ++i) {
+    g_input_only_connections[i].production_phase = kProductionPhaseAutomatic;
+    g_input_only_connections[i].connection_data =
+      &s_input_only_connection_data[i *
+                                    capacity->input_only_connections_per_point];
+  }
+  for (size_t i = 0; i < capacity->listen_only_connection_points; ++i) {
+    g_listen_only_connections[i].production_phase = kProductionPhaseAutomatic;
+    g_listen_only_connections[i].connection_data =
+      &s_listen_only_connection_data[i *
+                                     capacity->listen_only_connections_per_point];
+  }
+  return kEipStatusOk;
+}
+
+static void FreeIoConnectionData(void *const data) {
+  if (NULL != data) {
+    CipFree(data);
+  }
+}
+
+void ShutdownIoConnectionData(void) {
+  FreeIoConnectionData(g_exlusive_owner_connections);
+  FreeIoConnectionData(g_input_only_connections);
+  FreeIoConnectionData(s_input_only_connection_data);
+  FreeIoConnectionData(g_listen_only_connections);
+  FreeIoConnectionData(s_listen_only_connection_data);
+  g_exlusive_owner_connections = NULL;
+  g_input_only_connections = NULL;
+  s_input_only_connection_data = NULL;
+  g_listen_only_connections = NULL;
+  s_listen_only_connection_data = NULL;
 }
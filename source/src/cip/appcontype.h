@@ -8,7 +8,23 @@
 
 #include "cipconnectionmanager.h"
 
-void InitializeIoConnectionData(void);
+/** @brief Allocates the I/O connections of the connection points
+ *
+ *  @return kEipStatusOk on success, kEipStatusError if the connections could
+ *    not be allocated
+ */
+EipStatus InitializeIoConnectionData(void);
+
+/** @brief Frees the I/O connections, all of them have to be closed */
+void ShutdownIoConnectionData(void);
+
+/** @brief Gets the configured phase of the productions of an input assembly
+ *
+ *  @param input_assembly_id ID of the T-to-O point
+ *  @return the phase in 1/kProductionPhaseResolution of the RPI,
+ *    kProductionPhaseAutomatic if no phase has been configured
+ */
+CipUint GetProductionPhase(const unsigned int input_assembly_id);
 
 /** @brief check if for the given connection data received in a forward_open request
  *  a suitable connection is available.
@@ -152,6 +152,26 @@ EipStatus NotifyAssemblyConnectedDataReceived(CipInstance *const instance,
   return AfterAssemblyDataReceived(instance);
 }
 
+#ifdef OPENER_CONSUMED_DATA_ZERO_COPY
+EipStatus NotifyAssemblyConnectedDataReferenced(CipInstance *const instance,
+                                                const EipUint8 *const data,
+                                                const size_t data_length) {
+  CipByteArray *const assembly_byte_array =
+    (CipByteArray *) instance->attributes->data;
+  if(assembly_byte_array->length != data_length) {
+    OPENER_TRACE_ERR("wrong amount of data arrived for assembly object\n");
+    return kEipStatusError;
+  }
+
+  /* let attribute 3 reference the receive buffer during the notification */
+  EipByte *const assembly_data = assembly_byte_array->data;
+  assembly_byte_array->data = (EipByte *) data;
+  EipStatus status = AfterAssemblyDataReceived(instance);
+  assembly_byte_array->data = assembly_data;
+  return status;
+}
+#endif /* OPENER_CONSUMED_DATA_ZERO_COPY */
+
 int DecodeCipAssemblyAttribute3(void *const data,
                                 CipMessageRouterRequest *const message_router_request,
                                 CipMessageRouterResponse *const message_router_response)
@@ -58,4 +58,25 @@ EipStatus NotifyAssemblyConnectedDataReceived(CipInstance *const instance,
                                               const EipUint8 *const data,
                                               const size_t data_length);
 
+#ifdef OPENER_CONSUMED_DATA_ZERO_COPY
+/** @brief notify an Assembly object that I/O data has been received for it
+ *  without copying the data.
+ *
+ *  For the time of the AfterAssemblyDataReceived call attribute 3 of the
+ *  assembly object references the received data in the receive buffer,
+ *  afterwards it references the assembly's own data again. The application
+ *  has to read the data via the instance and must not modify it.
+ *
+ *  @param instance the assembly object instance for which the data was received
+ *  @param data pointer to the data received
+ *  @param data_length number of bytes received
+ *  @return
+ *     - kEipStatusOk the received data was okay
+ *     - kEipStatusError the received data was wrong
+ */
+EipStatus NotifyAssemblyConnectedDataReferenced(CipInstance *const instance,
+                                                const EipUint8 *const data,
+                                                const size_t data_length);
+#endif /* OPENER_CONSUMED_DATA_ZERO_COPY */
+
 #endif /* OPENER_CIPASSEMBLY_H_ */
@@ -9,17 +9,31 @@
 #include "cipclass3connection.h"
 
 #include "encap.h"
+#include "trace.h"
 
 /**** Global variables ****/
-extern CipConnectionObject explicit_connection_object_pool[
-  OPENER_CIP_NUM_EXPLICIT_CONNS];
+/** @brief Storage of the explicit connections */
+static CipConnectionObject *s_explicit_connections = NULL;
+
+/** @brief Stack of the explicit connections not in use */
+static CipConnectionObject **s_free_explicit_connections = NULL;
+
+/** @brief Number of explicit connections on the stack of free connections */
+static size_t s_number_of_free_explicit_connections = 0;
 
 CipConnectionObject *GetFreeExplicitConnection(void);
 
+/** @brief Closes an explicit connection and returns it to the free ones */
+static void CloseClass3Connection(CipConnectionObject *connection_object) {
+  CloseConnection(connection_object);
+  s_free_explicit_connections[s_number_of_free_explicit_connections++] =
+    connection_object;
+}
+
 void Class3ConnectionTimeoutHandler(CipConnectionObject *connection_object) {
   CheckForTimedOutConnectionsAndCloseTCPConnections(connection_object,
                                                     CloseSessionBySessionHandle);
-  CloseConnection(connection_object);
+  CloseClass3Connection(connection_object);
 }
 
 /**** Implementation ****/
@@ -44,33 +58,66 @@ CipError EstablishClass3Connection(
 
     /* set the connection call backs */
     explicit_connection->connection_close_function =
-      CloseConnection;
+      CloseClass3Connection;
     /* explicit connection have to be closed on time out*/
     explicit_connection->connection_timeout_function =
       Class3ConnectionTimeoutHandler;
 
-    AddNewActiveConnection(explicit_connection);
+    if(kEipStatusOk != AddNewActiveConnection(explicit_connection) ) {
+      ConnectionObjectInitializeEmpty(explicit_connection);
+      s_free_explicit_connections[s_number_of_free_explicit_connections++] =
+        explicit_connection;
+      cip_error = kCipErrorConnectionFailure;
+      *extended_error =
+        kConnectionManagerExtendedStatusCodeErrorNoMoreConnectionsAvailable;
+    }
   }
   return cip_error;
 }
 
-/** @brief Searches and returns a free explicit connection slot
+/** @brief Takes a free explicit connection slot
  *
  * @return Free explicit connection slot, or NULL if no slot is free
  */
 CipConnectionObject *GetFreeExplicitConnection(void) {
-  for (size_t i = 0; i < OPENER_CIP_NUM_EXPLICIT_CONNS; ++i) {
-    if (ConnectionObjectGetState(&(explicit_connection_object_pool[i]) ) ==
-        kConnectionObjectStateNonExistent) {
-      return &(explicit_connection_object_pool[i]);
-    }
+  if(0 == s_number_of_free_explicit_connections) {
+    return NULL;
   }
-  return NULL;
+  return s_free_explicit_connections[--s_number_of_free_explicit_connections];
 }
 
-void InitializeClass3ConnectionData(void) {
-  memset( explicit_connection_object_pool, 0,
-          OPENER_CIP_NUM_EXPLICIT_CONNS * sizeof(CipConnectionObject) );
+EipStatus InitializeClass3ConnectionData(const size_t number_of_connections) {
+  ShutdownClass3ConnectionData();
+  s_explicit_connections = CipCalloc(number_of_connections,
+                                     sizeof(CipConnectionObject) );
+  s_free_explicit_connections = CipCalloc(number_of_connections,
+                                          sizeof(CipConnectionObject *) );
+  if(0 != number_of_connections &&
+     (NULL == s_explicit_connections || NULL == s_free_explicit_connections) )
+  {
+    OPENER_TRACE_ERR("Could not allocate %zu explicit connections\n",
+                     number_of_connections);
+    ShutdownClass3ConnectionData();
+    return kEipStatusError;
+  }
+  /* the first connections are taken first */
+  for(size_t i = number_of_connections; i > 0; --i) {
+    s_free_explicit_connections[s_number_of_free_explicit_connections++] =
+      &s_explicit_connections[i - 1];
+  }
+  return kEipStatusOk;
+}
+
+void ShutdownClass3ConnectionData(void) {
+  if(NULL != s_explicit_connections) {
+    CipFree(s_explicit_connections);
+  }
+  if(NULL != s_free_explicit_connections) {
+    CipFree(s_free_explicit_connections);
+  }
+  s_explicit_connections = NULL;
+  s_free_explicit_connections = NULL;
+  s_number_of_free_explicit_connections = 0;
 }
 
 EipStatus CipClass3ConnectionObjectStateEstablishedHandler(
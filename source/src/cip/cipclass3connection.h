@@ -55,8 +55,16 @@ CipError EstablishClass3Connection(
 
 /** @brief Initializes the explicit connections mechanism
  *
- *  Prepares the available explicit connection slots for use at the start of the OpENer
+ *  Allocates the available explicit connection slots at the start of the OpENer
+ *  @param number_of_connections The number of explicit connection slots
+ *  @return kEipStatusOk on success, kEipStatusError if the slots could not be
+ *    allocated
  */
-void InitializeClass3ConnectionData(void);
+EipStatus InitializeClass3ConnectionData(const size_t number_of_connections);
+
+/** @brief Frees the explicit connection slots, all explicit connections have
+ *  to be closed
+ */
+void ShutdownClass3ConnectionData(void);
 
 #endif /* OPENER_CIPCLASS3CONNECTION_H_ */
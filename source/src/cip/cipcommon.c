@@ -87,6 +87,7 @@ EipStatus CipStackInit(const EipUint16 unique_connection_id) {
 void ShutdownCipStack(void) {
   /* First close all connections */
   CloseAllConnections();
+  ShutdownConnectionManager();
   /* Than free the sockets of currently active encapsulation sessions */
   EncapsulationShutDown();
   /*clean the data needed for the assembly object's attribute 3*/
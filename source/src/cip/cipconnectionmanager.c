@@ -5,6 +5,7 @@
  ******************************************************************************/
 #include <string.h>
 #include <stdbool.h>
+#include <stdlib.h>
 
 #include "cipconnectionmanager.h"
 
@@ -28,6 +29,7 @@
 #include "cipelectronickey.h"
 #include "cipqos.h"
 #include "xorshiftrandom.h"
+#include "hashindex.h"
 
 const size_t g_kForwardOpenHeaderLength = 36; /**< the length in bytes of the forward open command specific data till the start of the connection path (including con path size)*/
 const size_t g_kLargeForwardOpenHeaderLength = 40; /**< the length in bytes of the large forward open command specific data till the start of the connection path (including con path size)*/
@@ -48,6 +50,147 @@ ConnectionManagementHandling g_connection_management_list[2 +
                                                           OPENER_CIP_NUM_APPLICATION_SPECIFIC_CONNECTABLE_OBJECTS
 ] = {{0}};
 
+/** @brief Numbers of connections allocated by the next start of the stack */
+static ConnectionCapacity s_connection_capacity = {
+  .explicit_connections = OPENER_CIP_NUM_EXPLICIT_CONNS,
+  .exclusive_owner_connection_points = OPENER_CIP_NUM_EXLUSIVE_OWNER_CONNS,
+  .input_only_connection_points = OPENER_CIP_NUM_INPUT_ONLY_CONNS,
+  .input_only_connections_per_point =
+    OPENER_CIP_NUM_INPUT_ONLY_CONNS_PER_CON_PATH,
+  .listen_only_connection_points = OPENER_CIP_NUM_LISTEN_ONLY_CONNS,
+  .listen_only_connections_per_point =
+    OPENER_CIP_NUM_LISTEN_ONLY_CONNS_PER_CON_PATH
+};
+
+/** @brief Set while the connections of the capacity are allocated */
+static bool s_connections_allocated = false;
+
+/** @brief Storage of the connection timer queue, each active connection has a
+ * transmission trigger and a watchdog timer */
+static DeadlineQueueEntry **s_connection_timer_storage = NULL;
+
+/** @brief The connection timers of all active connections ordered by their
+ * expiry */
+static DeadlineQueue s_connection_timers;
+
+/** @brief Number of slots of the index of the active connections per
+ * connection, at least twice the number of connections remain after rounding
+ * to a power of two to keep the probe sequences short */
+#define CONNECTION_INDEX_SLOTS_PER_CONNECTION 4
+
+/** @brief Storage of the index of the active connections */
+static HashIndexEntry *s_connection_index_storage = NULL;
+
+/** @brief The active connections indexed by their consumed connection ID,
+ * looked up for each received connected data item */
+static HashIndex s_connection_index;
+
+/** @brief Storage of the index of the active I/O connections by their
+ * produced connection ID */
+static HashIndexEntry *s_produced_connection_index_storage = NULL;
+
+/** @brief The active I/O connections indexed by their produced connection ID,
+ * looked up for each transmit timestamp of a produced message */
+static HashIndex s_produced_connection_index;
+
+/** @brief Storage of the index of the active connections by their triad */
+static HashIndexEntry *s_connection_triad_index_storage = NULL;
+
+/** @brief The active connections indexed by their connection triad, looked up
+ * by Forward Open and Forward Close */
+static HashIndex s_connection_triad_index;
+
+/** @brief Storage of the index of the active connections by their produced
+ * assembly */
+static HashIndexEntry *s_produced_assembly_index_storage = NULL;
+
+/** @brief The active connections indexed by the instance of the assembly they
+ * produce, looked up by triggers and the handling of the connection points */
+static HashIndex s_produced_assembly_index;
+
+/** @brief Storage of the index of the active connections by their consumed
+ * assembly */
+static HashIndexEntry *s_consumed_assembly_index_storage = NULL;
+
+/** @brief The active connections indexed by the instance of the assembly they
+ * consume */
+static HashIndex s_consumed_assembly_index;
+
+/** @brief Storage of the index of the active connections by their consuming
+ * socket */
+static HashIndexEntry *s_consuming_socket_index_storage = NULL;
+
+/** @brief The active connections indexed by their consuming UDP socket,
+ * looked up for the sockets reported ready */
+static HashIndex s_consuming_socket_index;
+
+/** @brief The connection triad identifying a connection of an originator */
+typedef struct {
+  EipUint16 connection_serial_number;
+  EipUint16 originator_vendor_id;
+  EipUint32 originator_serial_number;
+} ConnectionTriad;
+
+/** @brief Gets the key of a connection triad in the triad index, different
+ * triads may share a key */
+static EipUint32 GetConnectionTriadKey(const ConnectionTriad *const triad) {
+  return ( ( (EipUint32) triad->originator_vendor_id << 16 ) |
+           triad->connection_serial_number ) ^
+         triad->originator_serial_number;
+}
+
+static ConnectionTriad GetConnectionTriad(
+  const CipConnectionObject *const connection_object) {
+  ConnectionTriad triad = {
+    .connection_serial_number = connection_object->connection_serial_number,
+    .originator_vendor_id = connection_object->originator_vendor_id,
+    .originator_serial_number = connection_object->originator_serial_number
+  };
+  return triad;
+}
+
+static bool HasConnectionTriad(const CipConnectionObject *const
+                               connection_object,
+                               const ConnectionTriad *const triad) {
+  return connection_object->connection_serial_number ==
+         triad->connection_serial_number &&
+         connection_object->originator_vendor_id ==
+         triad->originator_vendor_id &&
+         connection_object->originator_serial_number ==
+         triad->originator_serial_number;
+}
+
+static bool IsEstablishedConnectionWithTriad(const void *const
+                                             connection_object,
+                                             const void *const triad) {
+  return kConnectionObjectStateEstablished ==
+         ConnectionObjectGetState(connection_object) &&
+         HasConnectionTriad(connection_object, triad);
+}
+
+/** @brief Accepts connections which can be closed by a Forward Close */
+static bool IsClosableConnectionWithTriad(const void *const connection_object,
+                                          const void *const triad) {
+  const ConnectionObjectState state = ConnectionObjectGetState(
+    connection_object);
+  return (kConnectionObjectStateEstablished == state ||
+          kConnectionObjectStateTimedOut == state) &&
+         HasConnectionTriad(connection_object, triad);
+}
+
+/** @brief Time base of the connection timers */
+static MicroSeconds s_connection_manager_time = 0;
+
+/** @brief Phases of the productions of the connections with the RPI of a new
+ * connection, one per connection */
+static MicroSeconds *s_production_phase_storage = NULL;
+
+/** @brief Statistics of the productions of the connection timers */
+static ProductionStatistics s_production_statistics;
+
+/** @brief Messages produced in the current check of the connection timers */
+static CipUdint s_productions_in_cycle = 0;
+
 /** buffer connection object needed for forward open */
 CipConnectionObject g_dummy_connection_object;
 
@@ -91,6 +234,22 @@ EipStatus SearchConnectionData(CipInstance *instance,
                                const struct sockaddr *originator_address,
                                const CipUdint encapsulation_session);
 
+/** @brief Gets the time until the next production of a connection
+ *
+ * @param connection_object the connection
+ * @return remaining time in milliseconds, 0 if no production is scheduled
+ */
+static EipUint32 GetTransmissionTriggerTimerValue(
+  const CipConnectionObject *const connection_object) {
+  const DeadlineQueueEntry *const timer =
+    &connection_object->transmission_trigger_timer;
+  if( !DeadlineQueueEntryIsQueued(timer) ||
+      timer->deadline <= s_connection_manager_time ) {
+    return 0;
+  }
+  return (EipUint32) ( (timer->deadline - s_connection_manager_time) / 1000 );
+}
+
 void AssembleConnectionDataResponseMessage(
   CipMessageRouterResponse *message_router_response,
   CipConnectionObject *connection_object);
@@ -150,7 +309,7 @@ EipUint8 ParseConnectionPath(CipConnectionObject *connection_object,
 ConnectionManagementHandling *GetConnectionManagementEntry(
   const EipUint32 class_id);
 
-void InitializeConnectionManagerData(void);
+EipStatus InitializeConnectionManagerData(void);
 
 void AddNullAddressItem(
   CipCommonPacketFormatData *common_data_packet_format_data);
@@ -233,7 +392,9 @@ void InitializeConnectionManager(CipClass *class) {
 }
 
 EipStatus ConnectionManagerInit(EipUint16 unique_connection_id) {
-  InitializeConnectionManagerData();
+  if(kEipStatusOk != InitializeConnectionManagerData() ) {
+    return kEipStatusError;
+  }
 
   CipClass *connection_manager = CreateCipClass(kCipConnectionManagerClassCode, /* class code */
                                                 0, /* # of class attributes */
@@ -324,6 +485,9 @@ EipStatus HandleReceivedConnectedData(const EipUint8 *const data,
             connection_object->eip_level_sequence_count_consuming =
               g_common_packet_format_data_item.address_item.data.sequence_number;
             connection_object->eip_first_level_sequence_count_received = true;
+#if defined(OPENER_IO_TIMESTAMPING)
+            IoConnectionRecordReception(connection_object);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
 
             if(NULL != connection_object->connection_receive_data_function) {
               return connection_object->connection_receive_data_function(
@@ -693,33 +857,28 @@ EipStatus ForwardClose(CipInstance *instance,
 
   OPENER_TRACE_INFO("ForwardClose: ConnSerNo %d\n", connection_serial_number);
 
-  DoublyLinkedListNode *node = connection_list.first;
-
-  while(NULL != node) {
-    /* this check should not be necessary as only established connections should be in the active connection list */
-    CipConnectionObject *connection_object = node->data;
-    if( (kConnectionObjectStateEstablished ==
-         ConnectionObjectGetState(connection_object) )
-        || (kConnectionObjectStateTimedOut ==
-            ConnectionObjectGetState(connection_object) ) ) {
-      if( (connection_object->connection_serial_number ==
-           connection_serial_number) &&
-          (connection_object->originator_vendor_id == originator_vendor_id)
-          && (connection_object->originator_serial_number ==
-              originator_serial_number) ) {
-        /* found the corresponding connection object -> close it */
-        OPENER_ASSERT(NULL != connection_object->connection_close_function);
-        if( ( (struct sockaddr_in *) originator_address )->sin_addr.s_addr ==
-            connection_object->originator_address.sin_addr.s_addr ) {
-          connection_object->connection_close_function(connection_object);
-          connection_status = kConnectionManagerExtendedStatusCodeSuccess;
-        } else {
-          connection_status = kConnectionManagerExtendedStatusWrongCloser;
-        }
-        break;
-      }
+  const ConnectionTriad triad = {
+    .connection_serial_number = connection_serial_number,
+    .originator_vendor_id = originator_vendor_id,
+    .originator_serial_number = originator_serial_number
+  };
+  /* the state check should not be necessary as only established connections
+   * should be in the active connection list */
+  CipConnectionObject *connection_object = HashIndexFind(
+    &s_connection_triad_index,
+    GetConnectionTriadKey(&triad),
+    IsClosableConnectionWithTriad,
+    &triad);
+  if(NULL != connection_object) {
+    /* found the corresponding connection object -> close it */
+    OPENER_ASSERT(NULL != connection_object->connection_close_function);
+    if( ( (struct sockaddr_in *) originator_address )->sin_addr.s_addr ==
+        connection_object->originator_address.sin_addr.s_addr ) {
+      connection_object->connection_close_function(connection_object);
+      connection_status = kConnectionManagerExtendedStatusCodeSuccess;
+    } else {
+      connection_status = kConnectionManagerExtendedStatusWrongCloser;
     }
-    node = node->next;
   }
   if(kConnectionManagerExtendedStatusCodeErrorConnectionTargetConnectionNotFound
      == connection_status) {
@@ -907,7 +1066,7 @@ void AssembleConnectionDataResponseMessage(
   AddDintToMessage(connection_object->o_to_t_requested_packet_interval,
                    &message_router_response->message);
   // Originator API O->T UDINT
-  AddDintToMessage(connection_object->transmission_trigger_timer,
+  AddDintToMessage(GetTransmissionTriggerTimerValue(connection_object),
                    &message_router_response->message);
   // Originator T->O CID UDINT
   AddDintToMessage(connection_object->cip_produced_connection_id,
@@ -928,7 +1087,7 @@ void AssembleConnectionDataResponseMessage(
   AddDintToMessage(connection_object->t_to_o_requested_packet_interval,
                    &message_router_response->message);
   // Originator API T->O UDINT
-  AddDintToMessage(connection_object->transmission_trigger_timer,
+  AddDintToMessage(GetTransmissionTriggerTimerValue(connection_object),
                    &message_router_response->message);
 }
 
@@ -937,84 +1096,268 @@ EipStatus ManageConnections(MilliSeconds elapsed_time) {
   /*Inform application that it can execute */
   HandleApplication();
   ManageEncapsulationMessages(elapsed_time);
+  return kEipStatusOk;
+}
 
-  DoublyLinkedListNode *node = connection_list.first;
+/** @brief Schedules a connection timer, a full queue is an error in the
+ * configuration of the queue size
+ */
+static void ScheduleConnectionTimer(DeadlineQueueEntry *const timer,
+                                    const uint64_t deadline) {
+  if( !DeadlineQueueSchedule(&s_connection_timers, timer, deadline) ) {
+    OPENER_TRACE_ERR("connection timer queue full, timer not scheduled\n");
+  }
+}
 
-  while(NULL != node) {
-    //OPENER_TRACE_INFO("Entering Connection Object loop\n");
-    CipConnectionObject *connection_object = node->data;
-    if(kConnectionObjectStateEstablished ==
-       ConnectionObjectGetState(connection_object) ) {
-      if( (NULL != connection_object->consuming_instance) || /* we have a consuming connection check inactivity watchdog timer */
-          (kConnectionObjectTransportClassTriggerDirectionServer ==
-           ConnectionObjectGetTransportClassTriggerDirection(connection_object) ) ) /* all server connections have to maintain an inactivity watchdog timer */
-      {
-        if(elapsed_time >= connection_object->inactivity_watchdog_timer) {
-          /* we have a timed out connection perform watchdog time out action*/
-          OPENER_TRACE_INFO(">>>>>>>>>>Connection ConnNr: %u timed out\n",
-                            connection_object->connection_serial_number);
-          OPENER_ASSERT(NULL != connection_object->connection_timeout_function);
-          connection_object->connection_timeout_function(connection_object);
-        } else {
-          connection_object->inactivity_watchdog_timer -= elapsed_time;
-          connection_object->last_package_watchdog_timer -= elapsed_time;
-        }
-      }
-      /* only if the connection has not timed out check if data is to be send */
-      if(kConnectionObjectStateEstablished ==
-         ConnectionObjectGetState(connection_object) ) {
-        /* client connection */
-        if( (0 != ConnectionObjectGetExpectedPacketRate(connection_object) )
-            && (kEipInvalidSocket !=
-                connection_object->socket[kUdpCommuncationDirectionProducing]) ) /* only produce for the master connection */
-        {
-          if(kConnectionObjectTransportClassTriggerProductionTriggerCyclic !=
-             ConnectionObjectGetTransportClassTriggerProductionTrigger(
-               connection_object) ) {
-            /* non cyclic connections have to decrement production inhibit timer */
-            if(elapsed_time <= connection_object->production_inhibit_timer) {
-              //The connection is allowed to send again
-            } else {
-              connection_object->production_inhibit_timer -= elapsed_time;
-            }
-          }
+void ScheduleConnectionProduction(CipConnectionObject *const connection_object,
+                                  const uint64_t production_time) {
+  ScheduleConnectionTimer(&connection_object->transmission_trigger_timer,
+                          production_time);
+}
 
-          if(connection_object->transmission_trigger_timer <= elapsed_time) { /* need to send package */
-            OPENER_ASSERT(
-              NULL != connection_object->connection_send_data_function);
-            EipStatus eip_status =
-              connection_object->connection_send_data_function(connection_object);
-            if(eip_status == kEipStatusError) {
-              OPENER_TRACE_ERR(
-                "sending of UDP data in manage Connection failed\n");
-            }
-            /* add the RPI to the timer value */
-            connection_object->transmission_trigger_timer +=
-              ConnectionObjectGetRequestedPacketInterval(connection_object);
-            /* decrecment the elapsed time from timer value, if less than timer value */
-            if (connection_object->transmission_trigger_timer > elapsed_time) {
-              connection_object->transmission_trigger_timer -= elapsed_time;
-            } else {  /* elapsed time was longer than RPI */
-              connection_object->transmission_trigger_timer = 0;
-              OPENER_TRACE_INFO("elapsed time: %lu ms was longer than RPI: %u ms\n",
-                                elapsed_time,
-                                ConnectionObjectGetRequestedPacketInterval(connection_object));
-            }
-            if(kConnectionObjectTransportClassTriggerProductionTriggerCyclic !=
-               ConnectionObjectGetTransportClassTriggerProductionTrigger(
-                 connection_object) ) {
-              /* non cyclic connections have to reload the production inhibit timer */
-              ConnectionObjectResetProductionInhibitTimer(connection_object);
-            }
-          } else {
-            connection_object->transmission_trigger_timer -= elapsed_time;
-          }
-        }
+void ScheduleConnectionWatchdog(CipConnectionObject *const connection_object) {
+  /* the queued timer only has to be moved if the watchdog expires earlier,
+   * a later expiry is handled when the queued timer expires */
+  DeadlineQueueEntry *const timer = &connection_object->watchdog_timer;
+  if(DeadlineQueueEntryIsQueued(timer) &&
+     connection_object->inactivity_watchdog_deadline < timer->deadline) {
+    ScheduleConnectionTimer(timer,
+                            connection_object->inactivity_watchdog_deadline);
+  }
+}
+
+MicroSeconds GetConnectionManagerTime(void) {
+  return s_connection_manager_time;
+}
+
+/** @brief Handles an expired inactivity watchdog timer check
+ *
+ * Received packets only move the watchdog deadline of the connection, the
+ * queued timer is moved to it when it expires.
+ */
+static void HandleWatchdogTimer(CipConnectionObject *const connection_object) {
+  if( (NULL == connection_object->consuming_instance) && /* we have a consuming connection check inactivity watchdog timer */
+      (kConnectionObjectTransportClassTriggerDirectionServer !=
+       ConnectionObjectGetTransportClassTriggerDirection(connection_object) ) ) /* all server connections have to maintain an inactivity watchdog timer */
+  {
+    return;
+  }
+  if(s_connection_manager_time <
+     connection_object->inactivity_watchdog_deadline) {
+    ScheduleConnectionTimer(&connection_object->watchdog_timer,
+                            connection_object->inactivity_watchdog_deadline);
+    return;
+  }
+  /* we have a timed out connection perform watchdog time out action*/
+  OPENER_TRACE_INFO(">>>>>>>>>>Connection ConnNr: %u timed out\n",
+                    connection_object->connection_serial_number);
+  OPENER_ASSERT(NULL != connection_object->connection_timeout_function);
+  connection_object->connection_timeout_function(connection_object);
+}
+
+/** @brief Gets the interval of the productions of a connection, RPIs below
+ * the timer resolution are produced once per resolution step */
+static MicroSeconds GetProductionInterval(
+  const CipConnectionObject *const connection_object) {
+  const MicroSeconds production_interval =
+    ConnectionObjectGetRequestedPacketInterval(connection_object);
+  return 0 == production_interval ?
+         OPENER_CONNECTION_TIMER_RESOLUTION_IN_MICROSECONDS :
+         production_interval;
+}
+
+/** @brief Checks if a connection produces with its transmission trigger timer */
+static bool IsProducingConnection(
+  const CipConnectionObject *const connection_object) {
+  return 0 != ConnectionObjectGetExpectedPacketRate(connection_object) &&
+         kEipInvalidSocket !=
+         connection_object->socket[kUdpCommuncationDirectionProducing];
+}
+
+static int CompareProductionPhases(const void *const first,
+                                   const void *const second) {
+  const MicroSeconds first_phase = *(const MicroSeconds *) first;
+  const MicroSeconds second_phase = *(const MicroSeconds *) second;
+  return (first_phase > second_phase) - (first_phase < second_phase);
+}
+
+/** @brief Gets the phase of the productions of a new connection
+ *
+ * The phase is the offset of the productions within the production interval
+ * on the time base of the connection timers. Without a configured phase a
+ * connection producing the same assembly with the same interval as an active
+ * connection takes over its phase, so the assembly is produced once for both
+ * in one cycle. Otherwise the new connection is placed in the middle of the
+ * largest gap between the productions of the active connections with the
+ * same interval, so equal RPIs of different assemblies are not produced in
+ * the same cycle.
+ */
+static MicroSeconds GetProductionPhaseOfNewConnection(
+  const CipConnectionObject *const connection_object) {
+  const MicroSeconds production_interval = GetProductionInterval(
+    connection_object);
+  const CipUint configured_phase = GetProductionPhase(
+    connection_object->produced_path.instance_id);
+  if(kProductionPhaseAutomatic != configured_phase) {
+    return production_interval * configured_phase /
+           kProductionPhaseResolution;
+  }
+
+  size_t number_of_phases = 0;
+  for(const DoublyLinkedListNode *node = connection_list.first; NULL != node;
+      node = node->next) {
+    const CipConnectionObject *const other = node->data;
+    if(other != connection_object &&
+       kConnectionObjectStateEstablished == ConnectionObjectGetState(other) &&
+       IsProducingConnection(other) &&
+       DeadlineQueueEntryIsQueued(&other->transmission_trigger_timer) &&
+       production_interval == GetProductionInterval(other) ) {
+      const MicroSeconds phase = other->transmission_trigger_timer.deadline %
+                                 production_interval;
+      if(connection_object->produced_path.instance_id ==
+         other->produced_path.instance_id) {
+        return phase;
       }
+      s_production_phase_storage[number_of_phases++] = phase;
     }
-    node = node->next;
   }
-  return kEipStatusOk;
+  if(0 == number_of_phases) {
+    return s_connection_manager_time % production_interval;
+  }
+  qsort(s_production_phase_storage, number_of_phases, sizeof(MicroSeconds),
+        CompareProductionPhases);
+
+  /* the gap after the last phase wraps around to the first one */
+  MicroSeconds gap_start = s_production_phase_storage[number_of_phases - 1];
+  MicroSeconds largest_gap = production_interval - gap_start +
+                             s_production_phase_storage[0];
+  for(size_t i = 1; i < number_of_phases; i++) {
+    const MicroSeconds gap = s_production_phase_storage[i] -
+                             s_production_phase_storage[i - 1];
+    if(gap > largest_gap) {
+      largest_gap = gap;
+      gap_start = s_production_phase_storage[i - 1];
+    }
+  }
+  return (gap_start + largest_gap / 2) % production_interval;
+}
+
+/** @brief Gets the time of the first production of a new connection, the
+ * first time from now on with the production phase of the connection */
+static MicroSeconds GetFirstProductionTime(
+  const CipConnectionObject *const connection_object) {
+  if(!IsProducingConnection(connection_object) ) {
+    return s_connection_manager_time;
+  }
+  const MicroSeconds production_interval = GetProductionInterval(
+    connection_object);
+  const MicroSeconds phase = GetProductionPhaseOfNewConnection(
+    connection_object);
+  const MicroSeconds current_phase = s_connection_manager_time %
+                                     production_interval;
+  return s_connection_manager_time +
+         (phase + production_interval - current_phase) % production_interval;
+}
+
+/** @brief Adds the messages produced in the current cycle to the production
+ * statistics */
+static void RecordProductionCycle(void) {
+  if(0 == s_productions_in_cycle) {
+    return;
+  }
+  s_production_statistics.production_cycles++;
+  s_production_statistics.productions += s_productions_in_cycle;
+  if(s_productions_in_cycle >
+     s_production_statistics.max_productions_per_cycle) {
+    s_production_statistics.max_productions_per_cycle = s_productions_in_cycle;
+  }
+  s_productions_in_cycle = 0;
+}
+
+/** @brief Handles an expired transmission trigger timer */
+static void HandleTransmissionTriggerTimer(
+  CipConnectionObject *const connection_object) {
+  /* client connection */
+  if( (0 == ConnectionObjectGetExpectedPacketRate(connection_object) )
+      || (kEipInvalidSocket ==
+          connection_object->socket[kUdpCommuncationDirectionProducing]) ) /* only produce for the master connection */
+  {
+    return; /* rescheduled if the connection becomes the master connection */
+  }
+
+  OPENER_ASSERT(NULL != connection_object->connection_send_data_function);
+  EipStatus eip_status =
+    connection_object->connection_send_data_function(connection_object);
+  if(eip_status == kEipStatusError) {
+    OPENER_TRACE_ERR("sending of UDP data in manage Connection failed\n");
+  }
+  s_productions_in_cycle++;
+  const MicroSeconds production_interval = GetProductionInterval(
+    connection_object);
+  /* add the RPI to the timer value */
+  uint64_t next_production =
+    connection_object->transmission_trigger_timer.deadline +
+    production_interval;
+  if(next_production <= s_connection_manager_time) { /* elapsed time was longer than RPI */
+    OPENER_TRACE_INFO("production late by %llu us, RPI: %llu us\n",
+                      s_connection_manager_time -
+                      connection_object->transmission_trigger_timer.deadline,
+                      production_interval);
+    /* skips the missed productions keeping the phase of the connection */
+    next_production += ( (s_connection_manager_time - next_production) /
+                         production_interval + 1 ) * production_interval;
+  }
+  ScheduleConnectionProduction(connection_object, next_production);
+
+  if(kConnectionObjectTransportClassTriggerProductionTriggerCyclic !=
+     ConnectionObjectGetTransportClassTriggerProductionTrigger(
+       connection_object) ) {
+    /* non cyclic connections have to reload the production inhibit timer */
+    ConnectionObjectResetProductionInhibitTimer(connection_object);
+  }
+}
+
+void ManageConnectionTimers(const MicroSeconds current_time) {
+  s_connection_manager_time = current_time;
+
+  /* all connections due in this cycle are sent together after the loop */
+  BeginProductionBatch();
+
+  /* each timer queued at the start is handled at most once */
+  size_t remaining_timers = s_connection_timers.length;
+  DeadlineQueueEntry *timer = NULL;
+  while(0 < remaining_timers-- &&
+        NULL != ( timer = DeadlineQueuePopExpired(&s_connection_timers,
+                                                  current_time) ) ) {
+    CipConnectionObject *const connection_object = timer->data;
+    if(kConnectionObjectStateEstablished !=
+       ConnectionObjectGetState(connection_object) ) {
+      continue;
+    }
+    if(&connection_object->watchdog_timer == timer) {
+      HandleWatchdogTimer(connection_object);
+    } else {
+      HandleTransmissionTriggerTimer(connection_object);
+    }
+  }
+
+  EndProductionBatch();
+  RecordProductionCycle();
+}
+
+const ProductionStatistics *GetProductionStatistics(void) {
+  return &s_production_statistics;
+}
+
+MicroSeconds GetTimeToNextConnectionTimer(const MicroSeconds current_time,
+                                          const MicroSeconds max_time) {
+  const DeadlineQueueEntry *const next_timer = DeadlineQueuePeek(
+    &s_connection_timers);
+  if(NULL == next_timer || next_timer->deadline >= current_time + max_time) {
+    return max_time;
+  }
+  return next_timer->deadline > current_time ?
+         (MicroSeconds) (next_timer->deadline - current_time) : 0;
 }
 
 /** @brief Assembles the Forward Open Response
@@ -1207,57 +1550,93 @@ EipStatus AssembleForwardCloseResponse(EipUint16 connection_serial_number,
   return kEipStatusOkSend;
 }
 
+static bool IsEstablishedConnection(const void *const connection_object,
+                                    const void *const context) {
+  (void) context;
+  return kConnectionObjectStateEstablished ==
+         ConnectionObjectGetState(connection_object);
+}
+
 CipConnectionObject *GetConnectedObject(const EipUint32 connection_id) {
-  DoublyLinkedListNode *iterator = connection_list.first;
+  return HashIndexFind(&s_connection_index,
+                       connection_id,
+                       IsEstablishedConnection,
+                       NULL);
+}
 
-  while(NULL != iterator) {
-    if(kConnectionObjectStateEstablished ==
-       ConnectionObjectGetState(iterator->data)
-       && connection_id ==
-       ConnectionObjectGetCipConsumedConnectionID(iterator->data) ) {
-      return iterator->data;
-    }
-    iterator = iterator->next;
-  }
-  return NULL;
+/** @brief Accepts the connection sending the messages of its production, not
+ * the ones only sharing a multicast production */
+static bool HasProducingSocket(const void *const connection_object,
+                               const void *const context) {
+  (void) context;
+  return kEipInvalidSocket !=
+         ( (const CipConnectionObject *) connection_object )->socket[
+           kUdpCommuncationDirectionProducing];
 }
 
-CipConnectionObject *GetConnectedOutputAssembly(
-  const EipUint32 output_assembly_id) {
-  DoublyLinkedListNode *iterator = connection_list.first;
+CipConnectionObject *GetProducingConnection(
+  const EipUint32 produced_connection_id) {
+  return HashIndexFind(&s_produced_connection_index,
+                       produced_connection_id,
+                       HasProducingSocket,
+                       NULL);
+}
 
-  while(NULL != iterator) {
-    if(kConnectionObjectInstanceTypeIOExclusiveOwner ==
-       ConnectionObjectGetInstanceType(iterator->data)
-       && (kConnectionObjectStateEstablished ==
-           ConnectionObjectGetState(iterator->data)
-           || kConnectionObjectStateTimedOut ==
-           ConnectionObjectGetState(iterator->data) )
-       && output_assembly_id ==
-       ( (CipConnectionObject *) iterator->data )->produced_path.instance_id) {
-      return iterator->data;
-    }
-    iterator = iterator->next;
-  }
-  return NULL;
+CipConnectionObject *GetConnectionProducingAssembly(
+  const CipInstanceNum assembly_instance,
+  const HashIndexAcceptFunction accept,
+  const void *const context) {
+  return HashIndexFind(&s_produced_assembly_index, assembly_instance, accept,
+                       context);
 }
 
-CipConnectionObject *CheckForExistingConnection(
+CipConnectionObject *GetConnectionConsumingAssembly(
+  const CipInstanceNum assembly_instance,
+  const HashIndexAcceptFunction accept,
+  const void *const context) {
+  return HashIndexFind(&s_consumed_assembly_index, assembly_instance, accept,
+                       context);
+}
+
+/** @brief Checks if a connection consumes from a UDP socket */
+static bool HasConsumingSocket(
   const CipConnectionObject *const connection_object) {
+  return kEipInvalidSocket !=
+         connection_object->socket[kUdpCommuncationDirectionConsuming];
+}
 
-  DoublyLinkedListNode *iterator = connection_list.first;
+CipConnectionObject *GetConnectionConsumingFromSocket(const int socket) {
+  return HashIndexFind(&s_consuming_socket_index, (uint32_t) socket, NULL,
+                       NULL);
+}
 
-  while(NULL != iterator) {
-    if(kConnectionObjectStateEstablished ==
-       ConnectionObjectGetState(iterator->data) ) {
-      if(EqualConnectionTriad(connection_object, iterator->data) ) {
-        return iterator->data;
-      }
-    }
-    iterator = iterator->next;
-  }
+/** @brief Accepts exclusive owner connections which are established or timed
+ * out */
+static bool IsOpenExclusiveOwnerConnection(const void *const connection_object,
+                                           const void *const context) {
+  (void) context;
+  const ConnectionObjectState state = ConnectionObjectGetState(
+    connection_object);
+  return kConnectionObjectInstanceTypeIOExclusiveOwner ==
+         ConnectionObjectGetInstanceType(connection_object) &&
+         (kConnectionObjectStateEstablished == state ||
+          kConnectionObjectStateTimedOut == state);
+}
 
-  return NULL;
+CipConnectionObject *GetConnectedOutputAssembly(
+  const EipUint32 output_assembly_id) {
+  return GetConnectionProducingAssembly( (CipInstanceNum) output_assembly_id,
+                                         IsOpenExclusiveOwnerConnection,
+                                         NULL );
+}
+
+CipConnectionObject *CheckForExistingConnection(
+  const CipConnectionObject *const connection_object) {
+  const ConnectionTriad triad = GetConnectionTriad(connection_object);
+  return HashIndexFind(&s_connection_triad_index,
+                       GetConnectionTriadKey(&triad),
+                       IsEstablishedConnectionWithTriad,
+                       &triad);
 }
 
 EipStatus CheckElectronicKeyData(EipUint8 key_format,
@@ -1686,26 +2065,115 @@ void CloseConnection(CipConnectionObject *RESTRICT connection_object) {
   OPENER_TRACE_INFO("cipconnectionmanager: CloseConnection, trigger: %d \n",
   	ConnectionObjectGetTransportClassTriggerTransportClass(connection_object));
 
+  /* the connection is indexed by its consuming socket */
+  RemoveFromActiveConnections(connection_object);
   if(kConnectionObjectTransportClassTriggerTransportClass3 !=
      ConnectionObjectGetTransportClassTriggerTransportClass(connection_object) )
   {
     /* only close the UDP connection for not class 3 connections */
     CloseUdpSocket(connection_object->socket[kUdpCommuncationDirectionConsuming]);
+    if(connection_object->socket[kUdpCommuncationDirectionConsuming] !=
+       connection_object->socket[kUdpCommuncationDirectionProducing]) {
+      CloseUdpSocket(connection_object->socket[kUdpCommuncationDirectionProducing]);
+    }
     connection_object->socket[kUdpCommuncationDirectionConsuming] =
       kEipInvalidSocket;
-    CloseUdpSocket(connection_object->socket[kUdpCommuncationDirectionProducing]);
     connection_object->socket[kUdpCommuncationDirectionProducing] =
       kEipInvalidSocket;
   }
-  RemoveFromActiveConnections(connection_object);
   ConnectionObjectInitializeEmpty(connection_object);
 
 }
 
-void AddNewActiveConnection(CipConnectionObject *const connection_object) {
+/** @brief Removes a connection from the connection indexes, indexes not
+ * holding it are left unchanged */
+static void RemoveFromConnectionIndexes(
+  CipConnectionObject *const connection_object) {
+  const ConnectionTriad triad = GetConnectionTriad(connection_object);
+  HashIndexRemove(&s_connection_index,
+                  ConnectionObjectGetCipConsumedConnectionID(
+                    connection_object), connection_object);
+  HashIndexRemove(&s_connection_triad_index,
+                  GetConnectionTriadKey(&triad), connection_object);
+  if(ConnectionObjectIsTypeIOConnection(connection_object) ) {
+    HashIndexRemove(&s_produced_connection_index,
+                    ConnectionObjectGetCipProducedConnectionID(
+                      connection_object), connection_object);
+    HashIndexRemove(&s_produced_assembly_index,
+                    connection_object->produced_path.instance_id,
+                    connection_object);
+    HashIndexRemove(&s_consumed_assembly_index,
+                    connection_object->consumed_path.instance_id,
+                    connection_object);
+  }
+  if(HasConsumingSocket(connection_object) ) {
+    const int consuming_socket =
+      connection_object->socket[kUdpCommuncationDirectionConsuming];
+    if(HashIndexRemove(&s_consuming_socket_index, (uint32_t) consuming_socket,
+                       connection_object) &&
+       NULL == GetConnectionConsumingFromSocket(consuming_socket) ) {
+      RemoveConsumingUdpSocket(consuming_socket);
+    }
+  }
+}
+
+EipStatus AddNewActiveConnection(CipConnectionObject *const connection_object)
+{
+  const ConnectionTriad triad = GetConnectionTriad(connection_object);
+  bool is_indexed =
+    HashIndexInsert(&s_connection_index,
+                    ConnectionObjectGetCipConsumedConnectionID(
+                      connection_object), connection_object) &&
+    HashIndexInsert(&s_connection_triad_index,
+                    GetConnectionTriadKey(&triad), connection_object);
+  /* only I/O connections are looked up by their assemblies, explicit
+   * connections would pile up under the key of the message router */
+  if(is_indexed && ConnectionObjectIsTypeIOConnection(connection_object) ) {
+    is_indexed = HashIndexInsert(&s_produced_connection_index,
+                                 ConnectionObjectGetCipProducedConnectionID(
+                                   connection_object), connection_object) &&
+                 HashIndexInsert(&s_produced_assembly_index,
+                                 connection_object->produced_path.instance_id,
+                                 connection_object) &&
+                 HashIndexInsert(&s_consumed_assembly_index,
+                                 connection_object->consumed_path.instance_id,
+                                 connection_object);
+  }
+  const int consuming_socket =
+    connection_object->socket[kUdpCommuncationDirectionConsuming];
+  bool is_new_consuming_socket = false;
+  if(is_indexed && HasConsumingSocket(connection_object) ) {
+    is_new_consuming_socket = NULL == GetConnectionConsumingFromSocket(
+      consuming_socket);
+    is_indexed = HashIndexInsert(&s_consuming_socket_index,
+                                 (uint32_t) consuming_socket,
+                                 connection_object);
+  }
+  if(!is_indexed) {
+    OPENER_TRACE_ERR("Connection index is full\n");
+    RemoveFromConnectionIndexes(connection_object);
+    return kEipStatusError;
+  }
+  if(is_new_consuming_socket) {
+    AddConsumingUdpSocket(consuming_socket);
+  }
   DoublyLinkedListInsertAtHead(&connection_list, connection_object);
   ConnectionObjectSetState(connection_object,
                            kConnectionObjectStateEstablished);
+
+  /* the timer entries may have been copied from another connection object */
+  DeadlineQueueEntryInitialize(&connection_object->transmission_trigger_timer,
+                               connection_object);
+  DeadlineQueueEntryInitialize(&connection_object->watchdog_timer,
+                               connection_object);
+  ScheduleConnectionTimer(&connection_object->watchdog_timer,
+                          connection_object->inactivity_watchdog_deadline);
+  ScheduleConnectionProduction(connection_object,
+                               GetFirstProductionTime(connection_object) );
+#if defined(OPENER_IO_SOCKET_FILTER)
+  UpdateIoSocketFilter();
+#endif /* defined(OPENER_IO_SOCKET_FILTER) */
+  return kEipStatusOk;
 }
 
 void RemoveFromActiveConnections(CipConnectionObject *const connection_object) {
@@ -1713,28 +2181,29 @@ void RemoveFromActiveConnections(CipConnectionObject *const connection_object) {
       iterator = iterator->next) {
     if(iterator->data == connection_object) {
       DoublyLinkedListRemoveNode(&connection_list, &iterator);
+      RemoveFromConnectionIndexes(connection_object);
+      DeadlineQueueCancel(&s_connection_timers,
+                          &connection_object->transmission_trigger_timer);
+      DeadlineQueueCancel(&s_connection_timers,
+                          &connection_object->watchdog_timer);
+#if defined(OPENER_IO_SOCKET_FILTER)
+      UpdateIoSocketFilter();
+#endif /* defined(OPENER_IO_SOCKET_FILTER) */
       return;
     }
   } OPENER_TRACE_ERR("Connection not found in active connection list\n");
 }
 
-EipBool8 IsConnectedOutputAssembly(const CipInstanceNum instance_number) {
-  EipBool8 is_connected = false;
-
-  DoublyLinkedListNode *node = connection_list.first;
+static bool IsIoConnection(const void *const connection_object,
+                           const void *const context) {
+  (void) context;
+  return ConnectionObjectIsTypeIOConnection(connection_object);
+}
 
-  while(NULL != node) {
-    CipConnectionObject *connection_object = (CipConnectionObject *) node->data;
-    CipDword consumed_connection_point =
-      connection_object->consumed_path.instance_id;
-    if(instance_number == consumed_connection_point &&
-       true == ConnectionObjectIsTypeIOConnection(connection_object) ) {
-      is_connected = true;
-      break;
-    }
-    node = node->next;
-  }
-  return is_connected;
+EipBool8 IsConnectedOutputAssembly(const CipInstanceNum instance_number) {
+  return NULL != GetConnectionConsumingAssembly(instance_number,
+                                                IsIoConnection,
+                                                NULL);
 }
 
 EipStatus AddConnectableObject(const CipUdint class_code,
@@ -1771,29 +2240,61 @@ GetConnectionManagementEntry(const EipUint32 class_id) {
   return connection_management_entry;
 }
 
+/** @brief Produces a triggered connection right away
+ *
+ * The next production of the connection is due one RPI later unless it is
+ * triggered again.
+ */
+static void ProduceTriggeredConnection(
+  CipConnectionObject *const connection_object,
+  const MicroSeconds current_time) {
+  if(current_time > s_connection_manager_time) {
+    s_connection_manager_time = current_time;
+  }
+  OPENER_ASSERT(NULL != connection_object->connection_send_data_function);
+  if(kEipStatusError ==
+     connection_object->connection_send_data_function(connection_object) ) {
+    OPENER_TRACE_ERR("sending of triggered UDP data failed\n");
+  }
+  s_productions_in_cycle++;
+  RecordProductionCycle();
+  ScheduleConnectionProduction(connection_object,
+                               s_connection_manager_time +
+                               GetProductionInterval(connection_object) );
+  ConnectionObjectResetProductionInhibitTimer(connection_object);
+}
+
+/** @brief Accepts connections consuming the output assembly given as context */
+static bool IsConsumingAssembly(const void *const connection_object,
+                                const void *const output_assembly) {
+  return *(const unsigned int *) output_assembly ==
+         ( (const CipConnectionObject *) connection_object )->consumed_path.
+         instance_id;
+}
+
 EipStatus TriggerConnections(unsigned int output_assembly,
                              unsigned int input_assembly) {
-  EipStatus status = kEipStatusError;
+  CipConnectionObject *const connection_object =
+    GetConnectionProducingAssembly( (CipInstanceNum) input_assembly,
+                                    IsConsumingAssembly,
+                                    &output_assembly );
+  if(NULL == connection_object ||
+     kConnectionObjectTransportClassTriggerProductionTriggerCyclic ==
+     ConnectionObjectGetTransportClassTriggerProductionTrigger(
+       connection_object) ) {
+    return kEipStatusError;
+  }
 
-  DoublyLinkedListNode *node = connection_list.first;
-  while(NULL != node) {
-    CipConnectionObject *connection_object = node->data;
-    if( (output_assembly == connection_object->consumed_path.instance_id) &&
-        (input_assembly == connection_object->produced_path.instance_id) ) {
-      if(
-        kConnectionObjectTransportClassTriggerProductionTriggerApplicationObject
-        == ConnectionObjectGetTransportClassTriggerProductionTrigger(
-          connection_object) ) {
-        /* produce at the next allowed occurrence */
-        connection_object->transmission_trigger_timer =
-          connection_object->production_inhibit_time;
-        status = kEipStatusOk;
-      }
-      break;
-    }
-    node = node->next;
+  const MicroSeconds current_time = GetMicroSeconds();
+  if(current_time >= connection_object->production_inhibit_deadline &&
+     IsProducingConnection(connection_object) ) {
+    ProduceTriggeredConnection(connection_object, current_time);
+  } else {
+    /* produce as soon as the production inhibit time has expired */
+    ScheduleConnectionProduction(connection_object,
+                                 connection_object->production_inhibit_deadline);
   }
-  return status;
+  return kEipStatusOk;
 }
 
 void CheckForTimedOutConnectionsAndCloseTCPConnections(
@@ -1820,10 +2321,151 @@ void CheckForTimedOutConnectionsAndCloseTCPConnections(
   }
 }
 
-void InitializeConnectionManagerData() {
+EipStatus SetConnectionCapacity(const ConnectionCapacity *const capacity) {
+  if(s_connections_allocated) {
+    OPENER_TRACE_ERR(
+      "Connection capacity can not be changed while the stack is running\n");
+    return kEipStatusError;
+  }
+  s_connection_capacity = *capacity;
+  return kEipStatusOk;
+}
+
+const ConnectionCapacity *GetConnectionCapacity(void) {
+  return &s_connection_capacity;
+}
+
+/** @brief Gets the number of all connections of the connection capacity */
+static size_t GetNumberOfConnections(void) {
+  return s_connection_capacity.explicit_connections +
+         s_connection_capacity.exclusive_owner_connection_points +
+         s_connection_capacity.input_only_connection_points *
+         s_connection_capacity.input_only_connections_per_point +
+         s_connection_capacity.listen_only_connection_points *
+         s_connection_capacity.listen_only_connections_per_point;
+}
+
+EipStatus InitializeConnectionManagerData() {
   memset(g_connection_management_list,
          0,
          g_kNumberOfConnectableObjects * sizeof(ConnectionManagementHandling) );
-  InitializeClass3ConnectionData();
-  InitializeIoConnectionData();
+  ShutdownConnectionManager();
+
+  const size_t number_of_connections = GetNumberOfConnections();
+  s_connection_timer_storage = CipCalloc(2 * number_of_connections,
+                                         sizeof(DeadlineQueueEntry *) );
+  s_connection_index_storage = CipCalloc(
+    CONNECTION_INDEX_SLOTS_PER_CONNECTION * number_of_connections,
+    sizeof(HashIndexEntry) );
+  s_connection_triad_index_storage = CipCalloc(
+    CONNECTION_INDEX_SLOTS_PER_CONNECTION * number_of_connections,
+    sizeof(HashIndexEntry) );
+  s_produced_connection_index_storage = CipCalloc(
+    CONNECTION_INDEX_SLOTS_PER_CONNECTION * number_of_connections,
+    sizeof(HashIndexEntry) );
+  s_produced_assembly_index_storage = CipCalloc(
+    CONNECTION_INDEX_SLOTS_PER_CONNECTION * number_of_connections,
+    sizeof(HashIndexEntry) );
+  s_consumed_assembly_index_storage = CipCalloc(
+    CONNECTION_INDEX_SLOTS_PER_CONNECTION * number_of_connections,
+    sizeof(HashIndexEntry) );
+  s_consuming_socket_index_storage = CipCalloc(
+    CONNECTION_INDEX_SLOTS_PER_CONNECTION * number_of_connections,
+    sizeof(HashIndexEntry) );
+  s_production_phase_storage = CipCalloc(number_of_connections,
+                                         sizeof(MicroSeconds) );
+  if(NULL == s_connection_timer_storage || NULL == s_connection_index_storage
+     || NULL == s_connection_triad_index_storage
+     || NULL == s_produced_connection_index_storage
+     || NULL == s_produced_assembly_index_storage
+     || NULL == s_consumed_assembly_index_storage
+     || NULL == s_consuming_socket_index_storage
+     || NULL == s_production_phase_storage
+     || kEipStatusOk !=
+     CipConnectionObjectListArrayInitialize(number_of_connections)
+     || kEipStatusOk !=
+     InitializeClass3ConnectionData(s_connection_capacity.explicit_connections)
+     || kEipStatusOk != InitializeIoConnectionData() ) {
+    OPENER_TRACE_ERR("Could not allocate %zu connections\n",
+                     number_of_connections);
+    ShutdownConnectionManager();
+    return kEipStatusError;
+  }
+  DeadlineQueueInitialize(&s_connection_timers,
+                          s_connection_timer_storage,
+                          2 * number_of_connections);
+  HashIndexInitialize(&s_connection_index,
+                      s_connection_index_storage,
+                      CONNECTION_INDEX_SLOTS_PER_CONNECTION *
+                      number_of_connections);
+  HashIndexInitialize(&s_connection_triad_index,
+                      s_connection_triad_index_storage,
+                      CONNECTION_INDEX_SLOTS_PER_CONNECTION *
+                      number_of_connections);
+  HashIndexInitialize(&s_produced_connection_index,
+                      s_produced_connection_index_storage,
+                      CONNECTION_INDEX_SLOTS_PER_CONNECTION *
+                      number_of_connections);
+  HashIndexInitialize(&s_produced_assembly_index,
+                      s_produced_assembly_index_storage,
+                      CONNECTION_INDEX_SLOTS_PER_CONNECTION *
+                      number_of_connections);
+  HashIndexInitialize(&s_consumed_assembly_index,
+                      s_consumed_assembly_index_storage,
+                      CONNECTION_INDEX_SLOTS_PER_CONNECTION *
+                      number_of_connections);
+  HashIndexInitialize(&s_consuming_socket_index,
+                      s_consuming_socket_index_storage,
+                      CONNECTION_INDEX_SLOTS_PER_CONNECTION *
+                      number_of_connections);
+  memset(&s_production_statistics, 0, sizeof(s_production_statistics) );
+  s_connections_allocated = true;
+  return kEipStatusOk;
+}
+
+void ShutdownConnectionManager(void) {
+  ShutdownIoConnectionData();
+  FreeIoConnectionMessageBuffers();
+  ShutdownClass3ConnectionData();
+  CipConnectionObjectListArrayShutdown();
+  if(NULL != s_connection_timer_storage) {
+    CipFree(s_connection_timer_storage);
+  }
+  if(NULL != s_connection_index_storage) {
+    CipFree(s_connection_index_storage);
+  }
+  if(NULL != s_connection_triad_index_storage) {
+    CipFree(s_connection_triad_index_storage);
+  }
+  if(NULL != s_produced_connection_index_storage) {
+    CipFree(s_produced_connection_index_storage);
+  }
+  if(NULL != s_produced_assembly_index_storage) {
+    CipFree(s_produced_assembly_index_storage);
+  }
+  if(NULL != s_consumed_assembly_index_storage) {
+    CipFree(s_consumed_assembly_index_storage);
+  }
+  if(NULL != s_consuming_socket_index_storage) {
+    CipFree(s_consuming_socket_index_storage);
+  }
+  if(NULL != s_production_phase_storage) {
+    CipFree(s_production_phase_storage);
+  }
+  s_connection_timer_storage = NULL;
+  s_connection_index_storage = NULL;
+  s_connection_triad_index_storage = NULL;
+  s_produced_connection_index_storage = NULL;
+  s_produced_assembly_index_storage = NULL;
+  s_consumed_assembly_index_storage = NULL;
+  s_consuming_socket_index_storage = NULL;
+  s_production_phase_storage = NULL;
+  DeadlineQueueInitialize(&s_connection_timers, NULL, 0);
+  HashIndexInitialize(&s_connection_index, NULL, 0);
+  HashIndexInitialize(&s_connection_triad_index, NULL, 0);
+  HashIndexInitialize(&s_produced_connection_index, NULL, 0);
+  HashIndexInitialize(&s_produced_assembly_index, NULL, 0);
+  HashIndexInitialize(&s_consumed_assembly_index, NULL, 0);
+  HashIndexInitialize(&s_consuming_socket_index, NULL, 0);
+  s_connections_allocated = false;
 }
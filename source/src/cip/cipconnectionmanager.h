@@ -11,6 +11,7 @@
 #include "typedefs.h"
 #include "ciptypes.h"
 #include "cipconnectionobject.h"
+#include "hashindex.h"
 
 /**
  * @brief Connection Type constants of the Forward Open service request
@@ -171,6 +172,11 @@ static const CipUint kCipConnectionManagerClassCode = 0x06U;
  */
 EipStatus ConnectionManagerInit(EipUint16 unique_connection_id);
 
+/** @brief Frees the connections allocated by ConnectionManagerInit(), all
+ *  connections have to be closed
+ */
+void ShutdownConnectionManager(void);
+
 /** @brief Get a connected object dependent on requested ConnectionID.
  *
  *   @param connection_id Connection ID of the Connection Object to get
@@ -179,6 +185,17 @@ EipStatus ConnectionManagerInit(EipUint16 unique_connection_id);
  */
 CipConnectionObject *GetConnectedObject(const EipUint32 connection_id);
 
+/** @brief Finds the active I/O connection sending the messages of a produced
+ * connection ID
+ *
+ *   Connections sharing a multicast production with it are not found.
+ *
+ *   @param produced_connection_id T->O connection ID of the messages
+ *   @return the producing connection, NULL if there is none
+ */
+CipConnectionObject *GetProducingConnection(
+  const EipUint32 produced_connection_id);
+
 /**  Get a connection object for a given output assembly.
  *
  *   @param output_assembly_id requested output assembly of requested
@@ -189,6 +206,37 @@ CipConnectionObject *GetConnectedObject(const EipUint32 connection_id);
 CipConnectionObject *GetConnectedOutputAssembly(
   const EipUint32 output_assembly_id);
 
+/** @brief Finds an active connection producing an assembly
+ *
+ *   @param assembly_instance instance number of the produced assembly
+ *   @param accept accepts the connection looked for
+ *   @param context passed to the accept function
+ *   @return an accepted connection, NULL if no connection is accepted
+ */
+CipConnectionObject *GetConnectionProducingAssembly(
+  const CipInstanceNum assembly_instance,
+  const HashIndexAcceptFunction accept,
+  const void *const context);
+
+/** @brief Finds an active connection consuming an assembly
+ *
+ *   @param assembly_instance instance number of the consumed assembly
+ *   @param accept accepts the connection looked for
+ *   @param context passed to the accept function
+ *   @return an accepted connection, NULL if no connection is accepted
+ */
+CipConnectionObject *GetConnectionConsumingAssembly(
+  const CipInstanceNum assembly_instance,
+  const HashIndexAcceptFunction accept,
+  const void *const context);
+
+/** @brief Finds an active connection consuming from a UDP socket
+ *
+ *   @param socket the consuming socket
+ *   @return a connection consuming from the socket, NULL if there is none
+ */
+CipConnectionObject *GetConnectionConsumingFromSocket(const int socket);
+
 /** @brief Close the given connection
  *
  * This function will take the data form the connection and correctly closes the
@@ -209,8 +257,10 @@ EipBool8 IsConnectedOutputAssembly(const CipInstanceNum instance_number);
  * production inhibit, etc).
  *
  * @param connection_object pointer to the connection object to be added.
+ * @return kEipStatusOk on success, kEipStatusError if the connection indexes
+ *  are full, the connection is then not added
  */
-void AddNewActiveConnection(CipConnectionObject *const connection_object);
+EipStatus AddNewActiveConnection(CipConnectionObject *const connection_object);
 
 /** @brief Removes connection from the list of active connections
  *
@@ -221,6 +271,29 @@ void RemoveFromActiveConnections(CipConnectionObject *const connection_object);
 
 CipUdint GetConnectionId(void);
 
+/** @brief Gets the current time of the connection timers
+ *
+ * The time is updated by ManageConnectionTimers(), all deadlines of the
+ * connection objects are absolute times on this time base.
+ * @return current time in microseconds
+ */
+MicroSeconds GetConnectionManagerTime(void);
+
+/** @brief Schedules the next production of an active connection
+ *
+ * @param connection_object the producing connection
+ * @param production_time absolute time of the production
+ */
+void ScheduleConnectionProduction(CipConnectionObject *const connection_object,
+                                  const uint64_t production_time);
+
+/** @brief Updates the queued watchdog timer of an active connection after its
+ * inactivity watchdog deadline has changed
+ *
+ * @param connection_object the connection
+ */
+void ScheduleConnectionWatchdog(CipConnectionObject *const connection_object);
+
 typedef void (*CloseSessionFunction)(const CipConnectionObject *const
                                      connection_object);
 
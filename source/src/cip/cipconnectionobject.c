@@ -56,25 +56,45 @@
 /** @brief Definition of the global connection list */
 DoublyLinkedList connection_list;
 
-/** @brief Array of the available explicit connections */
-CipConnectionObject explicit_connection_object_pool[
-  OPENER_CIP_NUM_EXPLICIT_CONNS];
+/** @brief Storage of the nodes of the connection list */
+static DoublyLinkedListNode *s_connection_list_nodes = NULL;
+
+/** @brief Nodes of the connection list not in use, linked by their next
+ * pointer */
+static DoublyLinkedListNode *s_free_connection_list_nodes = NULL;
+
+EipStatus CipConnectionObjectListArrayInitialize(const size_t number_of_nodes)
+{
+  CipConnectionObjectListArrayShutdown();
+  s_connection_list_nodes = CipCalloc(number_of_nodes,
+                                      sizeof(DoublyLinkedListNode) );
+  if(NULL == s_connection_list_nodes && 0 != number_of_nodes) {
+    OPENER_TRACE_ERR("Could not allocate %zu connection list nodes\n",
+                     number_of_nodes);
+    return kEipStatusError;
+  }
+  for(size_t i = number_of_nodes; i > 0; --i) {
+    s_connection_list_nodes[i - 1].next = s_free_connection_list_nodes;
+    s_free_connection_list_nodes = &s_connection_list_nodes[i - 1];
+  }
+  return kEipStatusOk;
+}
+
+void CipConnectionObjectListArrayShutdown(void) {
+  if(NULL != s_connection_list_nodes) {
+    CipFree(s_connection_list_nodes);
+  }
+  s_connection_list_nodes = NULL;
+  s_free_connection_list_nodes = NULL;
+}
 
 DoublyLinkedListNode *CipConnectionObjectListArrayAllocator() {
-  enum {
-    kNodesAmount = OPENER_CIP_NUM_EXPLICIT_CONNS +
-                   OPENER_CIP_NUM_INPUT_ONLY_CONNS +
-                   OPENER_CIP_NUM_EXLUSIVE_OWNER_CONNS +
-                   OPENER_CIP_NUM_LISTEN_ONLY_CONNS
-  };
-  static DoublyLinkedListNode nodes[kNodesAmount] = { 0 };
-  for(size_t i = 0; i < kNodesAmount; ++i) {
-    if(nodes[i].previous == NULL && nodes[i].next == NULL &&
-       nodes[i].data == NULL) {
-      return &nodes[i];
-    }
+  DoublyLinkedListNode *const node = s_free_connection_list_nodes;
+  if(NULL != node) {
+    s_free_connection_list_nodes = node->next;
+    node->next = NULL;
   }
-  return NULL;
+  return node;
 }
 
 void CipConnectionObjectListArrayFree(DoublyLinkedListNode **node) {
@@ -82,6 +102,8 @@ void CipConnectionObjectListArrayFree(DoublyLinkedListNode **node) {
   if(NULL != node) {
     if(NULL != *node) {
       memset(*node, 0, sizeof(DoublyLinkedListNode) );
+      (*node)->next = s_free_connection_list_nodes;
+      s_free_connection_list_nodes = *node;
       *node = NULL;
     } else {
       OPENER_TRACE_ERR("Attempt to delete NULL pointer to node\n");
@@ -103,6 +125,10 @@ void ConnectionObjectSetInitialInactivityWatchdogTimerValue(
 void ConnectionObjectInitializeEmpty(
   CipConnectionObject *const connection_object) {
   memset(connection_object, 0, sizeof(*connection_object) );
+  DeadlineQueueEntryInitialize(&connection_object->transmission_trigger_timer,
+                               connection_object);
+  DeadlineQueueEntryInitialize(&connection_object->watchdog_timer,
+                               connection_object);
   ConnectionObjectSetState(connection_object,
                            kConnectionObjectStateNonExistent);
   connection_object->socket[0] = kEipInvalidSocket;
@@ -442,34 +468,30 @@ CipUint ConnectionObjectGetExpectedPacketRate(
   return connection_object->expected_packet_rate;
 }
 
-CipUint ConnectionObjectGetRequestedPacketInterval(
+CipUdint ConnectionObjectGetRequestedPacketInterval(
   const CipConnectionObject *const connection_object) {
   CipUdint remainder_to_resolution =
     (connection_object->t_to_o_requested_packet_interval) %
-    (kOpenerTimerTickInMilliSeconds * 1000);
-  if(0 == remainder_to_resolution) { /* Value can be represented in multiples of the timer resolution */
-    return (CipUint) (connection_object->t_to_o_requested_packet_interval /
-                      1000);
-  } else {
-    return (CipUint) (connection_object->t_to_o_requested_packet_interval /
-                      1000 - remainder_to_resolution / 1000);
-  }
+    OPENER_CONNECTION_TIMER_RESOLUTION_IN_MICROSECONDS;
+  return connection_object->t_to_o_requested_packet_interval -
+         remainder_to_resolution;
 }
 
 void ConnectionObjectSetExpectedPacketRate(
   CipConnectionObject *const connection_object) {
   CipUdint remainder_to_resolution =
     (connection_object->t_to_o_requested_packet_interval) %
-    (kOpenerTimerTickInMilliSeconds * 1000);
-  if(0 == remainder_to_resolution) { /* Value can be represented in multiples of the timer resolution */
-    connection_object->expected_packet_rate =
-      connection_object->t_to_o_requested_packet_interval / 1000;
-  } else {
-    connection_object->expected_packet_rate =
-      connection_object->t_to_o_requested_packet_interval / 1000
-      + ( (CipUdint)
-          kOpenerTimerTickInMilliSeconds - remainder_to_resolution / 1000 );
+    OPENER_CONNECTION_TIMER_RESOLUTION_IN_MICROSECONDS;
+  CipUdint expected_packet_rate_in_microseconds =
+    connection_object->t_to_o_requested_packet_interval;
+  if(0 != remainder_to_resolution) { /* Round up to the next multiple of the timer resolution */
+    expected_packet_rate_in_microseconds +=
+      OPENER_CONNECTION_TIMER_RESOLUTION_IN_MICROSECONDS -
+      remainder_to_resolution;
   }
+  /* the attribute is given in milliseconds */
+  connection_object->expected_packet_rate =
+    (CipUint) ( (expected_packet_rate_in_microseconds + 999) / 1000 );
 }
 
 CipUdint ConnectionObjectGetCipProducedConnectionID(
@@ -584,34 +606,36 @@ void ConnectionObjectSetProductionInhibitTime(
 /*setup the preconsumption timer: max(ConnectionTimeoutMultiplier * ExpectedPacketRate, 10s) */
 void ConnectionObjectSetInitialInactivityWatchdogTimerValue(
   CipConnectionObject *const connection_object) {
-  const uint64_t kMinimumInitialTimeoutValue = 10000;
+  const uint64_t kMinimumInitialTimeoutValue = 10000000; /* 10 s */
   const uint64_t calculated_timeout_value =
     ConnectionObjectCalculateRegularInactivityWatchdogTimerValue(
       connection_object);
-  connection_object->inactivity_watchdog_timer =
-    (calculated_timeout_value >
-     kMinimumInitialTimeoutValue) ? calculated_timeout_value :
-    kMinimumInitialTimeoutValue;
+  connection_object->inactivity_watchdog_deadline =
+    GetConnectionManagerTime() +
+    ( (calculated_timeout_value > kMinimumInitialTimeoutValue) ?
+      calculated_timeout_value : kMinimumInitialTimeoutValue );
 }
 
 void ConnectionObjectResetInactivityWatchdogTimerValue(
   CipConnectionObject *const connection_object) {
-  connection_object->inactivity_watchdog_timer =
+  connection_object->inactivity_watchdog_deadline =
+    GetConnectionManagerTime() +
     ConnectionObjectCalculateRegularInactivityWatchdogTimerValue(
       connection_object);
+  ScheduleConnectionWatchdog(connection_object);
 }
 
 void ConnectionObjectResetLastPackageInactivityTimerValue(
   CipConnectionObject *const connection_object) {
-  connection_object->last_package_watchdog_timer =
+  connection_object->last_package_watchdog_deadline =
+    GetConnectionManagerTime() +
     ConnectionObjectCalculateRegularInactivityWatchdogTimerValue(
       connection_object);
 }
 
 uint64_t ConnectionObjectCalculateRegularInactivityWatchdogTimerValue(
   const CipConnectionObject *const connection_object) {
-  return ( ( (uint64_t)(connection_object->o_to_t_requested_packet_interval) /
-             (uint64_t) 1000 ) <<
+  return ( (uint64_t)(connection_object->o_to_t_requested_packet_interval) <<
            (2 + connection_object->connection_timeout_multiplier) );
 }
 
@@ -912,8 +936,9 @@ void ConnectionObjectResetSequenceCounts(
 
 void ConnectionObjectResetProductionInhibitTimer(
   CipConnectionObject *const connection_object) {
-  connection_object->production_inhibit_timer =
-    connection_object->production_inhibit_time;
+  connection_object->production_inhibit_deadline =
+    GetConnectionManagerTime() +
+    (uint64_t) connection_object->production_inhibit_time * 1000ULL;
 }
 
 void ConnectionObjectGeneralConfiguration(
@@ -947,7 +972,7 @@ void ConnectionObjectGeneralConfiguration(
 
   ConnectionObjectResetProductionInhibitTimer(connection_object);
 
-  connection_object->transmission_trigger_timer = 0;
+  /* the first production is scheduled when the connection gets active */
 }
 
 bool ConnectionObjectEqualOriginator(const CipConnectionObject *const object1,
@@ -12,11 +12,29 @@
 #include "opener_user_conf.h"
 #include "opener_api.h"
 #include "doublylinkedlist.h"
+#include "deadlinequeue.h"
+#include "messagebufferpool.h"
 #include "cipelectronickey.h"
 #include "cipepath.h"
 
 #define CIP_CONNECTION_OBJECT_CODE 0x05
 
+/** @brief Maximum length of a produced I/O message up to the data: item
+ * count, sequenced address item, data item type and length, sequence count
+ * and run/idle header */
+#define CIP_PRODUCED_MESSAGE_HEADER_MAXIMUM_LENGTH 24
+
+/** @brief Resolution of the connection timers in microseconds
+ *
+ *  Requested packet intervals are served in multiples of this value. Values
+ *  below the timer tick allow sub-millisecond RPIs, the network handler then
+ *  waits for the exact deadline of the next connection timer.
+ */
+#ifndef OPENER_CONNECTION_TIMER_RESOLUTION_IN_MICROSECONDS
+  #define OPENER_CONNECTION_TIMER_RESOLUTION_IN_MICROSECONDS \
+  ( (CipUdint) kOpenerTimerTickInMilliSeconds * 1000U)
+#endif
+
 typedef enum {
   kConnectionObjectStateNonExistent = 0, /**< Connection is non existent */
   kConnectionObjectStateConfiguring, /**< Waiting for both to be configured and to apply the configuration */
@@ -131,14 +149,20 @@ struct cip_connection_object {
 
   CipInstance *producing_instance;
   CipInstance *consuming_instance;
+  MessageBuffer *produced_data_buffer; /* pooled buffer sized for the produced
+                                          connection, holds the produced data */
 
   CipUint requested_produced_connection_size;
   CipUint requested_consumed_connection_size;
 
-  uint64_t transmission_trigger_timer;
-  uint64_t inactivity_watchdog_timer;
-  uint64_t last_package_watchdog_timer;
-  uint64_t production_inhibit_timer;
+  /* Connection timers, all times are absolute times of the connection manager
+   * time base, see GetConnectionManagerTime() */
+  DeadlineQueueEntry transmission_trigger_timer; /**< queued next production */
+  DeadlineQueueEntry watchdog_timer; /**< queued check of the inactivity watchdog */
+  uint64_t inactivity_watchdog_deadline; /**< expiry of the inactivity watchdog */
+  uint64_t last_package_watchdog_deadline; /**< inactivity watchdog expiry set by
+                                              the last received packet */
+  uint64_t production_inhibit_deadline; /**< no production before this time */
 
   CipUint connection_serial_number;
   CipUint originator_vendor_id;
@@ -175,6 +199,18 @@ struct cip_connection_object {
 
   /* Sockets for consuming and producing connection */
   int socket[2];
+  CipBool producing_socket_is_connected; /* the producing socket is connected
+                                            to remote_address */
+  /* the produced messages up to the data, built when the connection is
+   * established, only the sequence numbers and the run/idle state change */
+  CipOctet produced_message_header[CIP_PRODUCED_MESSAGE_HEADER_MAXIMUM_LENGTH];
+  CipUsint produced_message_header_length; /**< 0 if the header is not built */
+  CipBool produced_message_header_has_run_idle; /**< the header ends with the
+                                                   run/idle header */
+#if defined(OPENER_IO_TIMESTAMPING)
+  IoConnectionLatency latency; /**< measured with the network timestamps */
+  MicroSeconds last_receive_time; /**< reception of the last consumed message */
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
 
   struct sockaddr_in remote_address; /* socket address for produce */
   struct sockaddr_in originator_address; /* the address of the originator that
@@ -199,8 +235,25 @@ struct cip_connection_object {
 /** @brief Extern declaration of the global connection list */
 extern DoublyLinkedList connection_list;
 
+/** @brief Allocates the nodes of the connection list, one per connection
+ *
+ * @param number_of_nodes The number of connections
+ * @return kEipStatusOk on success, kEipStatusError if the memory could not
+ *  be allocated
+ */
+EipStatus CipConnectionObjectListArrayInitialize(const size_t number_of_nodes);
+
+/** @brief Frees the nodes of the connection list */
+void CipConnectionObjectListArrayShutdown(void);
+
+/** @brief Takes a node of the connection list from the free list
+ *
+ * @return The node, NULL if all nodes are in use
+ */
 DoublyLinkedListNode *CipConnectionObjectListArrayAllocator(
   );
+
+/** @brief Returns a node of the connection list to the free list */
 void CipConnectionObjectListArrayFree(DoublyLinkedListNode **node);
 
 /** @brief Array allocator
@@ -268,7 +321,13 @@ void ConnectionObjectSetConsumedConnectionSize(
 CipUint ConnectionObjectGetExpectedPacketRate(
   const CipConnectionObject *const connection_object);
 
-CipUint ConnectionObjectGetRequestedPacketInterval(
+/**
+ * @brief Gets the T->O requested packet interval which can be served
+ *
+ * @param connection_object The connection object
+ * @return The T->O RPI rounded down to the timer resolution in microseconds
+ */
+CipUdint ConnectionObjectGetRequestedPacketInterval(
   const CipConnectionObject *const connection_object);
 
 /**
@@ -49,6 +49,9 @@ void CloseIoConnection(CipConnectionObject *RESTRICT connection_object);
 
 void HandleIoConnectionTimeOut(CipConnectionObject *connection_object);
 
+static void CloseCommunicationChannels(
+  CipConnectionObject *const connection_object);
+
 /** @brief  Send the data from the produced CIP Object of the connection via the socket of the connection object
  *   on UDP.
  *      @param connection_object  pointer to the connection object
@@ -57,6 +60,22 @@ void HandleIoConnectionTimeOut(CipConnectionObject *connection_object);
  */
 EipStatus SendConnectedData(CipConnectionObject *connection_object);
 
+/** @brief Assembles the IO message of a producing connection up to the data
+ * of the produced assembly
+ *      @param connection_object  pointer to the connection object
+ *      @param data_changed  the application changed the data of the assembly
+ *      @param outgoing_message  initialized message to be filled
+ */
+void AssembleConnectedDataHeader(CipConnectionObject *connection_object,
+                                 const bool data_changed,
+                                 ENIPMessage *const outgoing_message);
+
+/** @brief Sends the messages collected in the production batch */
+void FlushProductionBatch(void);
+
+static void BuildProducedMessageHeader(
+  CipConnectionObject *const connection_object);
+
 EipStatus HandleReceivedIoConnectionData(CipConnectionObject *connection_object,
                                          const EipUint8 *data,
                                          EipUint16 data_length);
@@ -67,6 +86,41 @@ unsigned int g_config_data_length = 0; /**< length of g_config_data_buffer. Init
 
 EipUint32 g_run_idle_state = 0; /**< buffer for holding the run idle information. */
 
+/**** Local variables ****/
+static UdpDataBatchEntry s_production_batch[OPENER_UDP_SEND_BATCH_SIZE]; /**< pooled messages of the connections produced in one cycle */
+static CipUdint s_production_batch_connection_ids[OPENER_UDP_SEND_BATCH_SIZE]; /**< produced connection IDs of the batched messages, for error reports */
+static size_t s_production_batch_length = 0; /**< number of messages in the production batch */
+static bool s_production_batch_active = false; /**< messages are batched instead of sent immediately */
+static MessageBufferPool s_produced_data_pool = {
+  .allocator = CipCalloc,
+  .deallocator = CipFree
+}; /**< buffers of the producing connections, sized by their connection size */
+
+/** @brief Layout of the produced messages, see BuildProducedMessageHeader() */
+enum {
+  kProducedMessageConnectionIdEnd = 10, /**< item count, address item type
+                                           and length and connection ID
+                                           precede the sequence number */
+  kProducedMessageDataItemHeaderLength = 4 /**< data item type and length
+                                              precede the sequence count */
+};
+
+/** @brief Snapshot of an assembly produced by the messages of the production
+ * batch */
+typedef struct {
+  const CipInstance *instance; /**< the produced assembly */
+  bool data_changed; /**< result of BeforeAssemblyDataSend() */
+  size_t length; /**< length of the data */
+  const EipUint8 *data; /**< the data of the assembly sent by all its messages,
+                           kept in the buffer of the first connection */
+} ProducedAssembly;
+
+static ProducedAssembly s_produced_assemblies[OPENER_UDP_SEND_BATCH_SIZE]; /**< assemblies produced by the messages of the production batch */
+static size_t s_number_of_produced_assemblies = 0; /**< number of assemblies in s_produced_assemblies */
+#if defined(OPENER_IO_TIMESTAMPING)
+static MicroSeconds s_connected_data_receive_time = 0; /**< reception of the datagram handled next, 0 if unknown */
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+
 /**** Local variables, set by API, with build-time defaults ****/
 #ifdef OPENER_CONSUMED_DATA_HAS_RUN_IDLE_HEADER
 static EipUint8 s_consume_run_idle = 1;
@@ -359,13 +413,42 @@ CipError EstablishIoConnection(
     }
   }
 
+  if(target_to_originator_connection_type !=
+     kConnectionObjectConnectionTypeNull) {
+    /* only connections producing large data need large buffers */
+    io_connection_object->produced_data_buffer = MessageBufferPoolAcquire(
+      &s_produced_data_pool,
+      ConnectionObjectGetTToOConnectionSize(io_connection_object) );
+    if(NULL == io_connection_object->produced_data_buffer) {
+      *extended_error =
+        kConnectionManagerExtendedStatusCodeNoBufferMemoryAvailable;
+      return kCipErrorConnectionFailure;
+    }
+  }
+
   cip_error = OpenCommunicationChannels(io_connection_object);
   if(kCipErrorSuccess != cip_error) {
+    MessageBufferPoolRelease(&s_produced_data_pool,
+                             io_connection_object->produced_data_buffer);
+    io_connection_object->produced_data_buffer = NULL;
     *extended_error = 0; /*TODO find out the correct extended error code*/
     return cip_error;
   }
+  if(target_to_originator_connection_type !=
+     kConnectionObjectConnectionTypeNull) {
+    /* the produced connection ID is known once the channels are open */
+    BuildProducedMessageHeader(io_connection_object);
+  }
 
-  AddNewActiveConnection(io_connection_object);
+  if(kEipStatusOk != AddNewActiveConnection(io_connection_object) ) {
+    CloseCommunicationChannels(io_connection_object);
+    MessageBufferPoolRelease(&s_produced_data_pool,
+                             io_connection_object->produced_data_buffer);
+    ConnectionObjectInitializeEmpty(io_connection_object);
+    *extended_error =
+      kConnectionManagerExtendedStatusCodeErrorNoMoreConnectionsAvailable;
+    return kCipErrorConnectionFailure;
+  }
   CheckIoConnectionEvent(io_connection_object->consumed_path.instance_id,
                          io_connection_object->produced_path.instance_id,
                          kIoConnectionEventOpened);
@@ -416,19 +499,33 @@ EipStatus OpenConsumingPointToPointConnection(
       kOpenerEipIoUdpPort) };
 
   CipUsint qos_for_socket = ConnectionObjectGetTToOPriority(connection_object);
+  /* store the address of the originator for packet scanning */
+  connection_object->originator_address.sin_family = AF_INET;
+  connection_object->originator_address.sin_addr.s_addr = GetPeerAddress();
+  connection_object->originator_address.sin_port = htons(kOpenerEipIoUdpPort);
+
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+  /* the network stack hands the datagrams of the originator to this socket */
+  connection_object->socket[kUdpCommuncationDirectionConsuming] =
+    CreateConnectedUdpSocket(&connection_object->originator_address,
+                             qos_for_socket);
+  if(kEipInvalidSocket ==
+     connection_object->socket[kUdpCommuncationDirectionConsuming]) {
+    OPENER_TRACE_ERR(
+      "cannot open connected UDP socket in OpenPointToPointConnection\n");
+    return kEipStatusError;
+  }
+#else
   int error = SetQos(qos_for_socket);
   if (error != 0) {
     OPENER_TRACE_ERR(
       "cannot set QoS for UDP socket in OpenPointToPointConnection\n");
     return kEipStatusError;
   }
-  /* store the address of the originator for packet scanning */
-  connection_object->originator_address.sin_family = AF_INET;
-  connection_object->originator_address.sin_addr.s_addr = GetPeerAddress();
-  connection_object->originator_address.sin_port = htons(kOpenerEipIoUdpPort);
 
   connection_object->socket[kUdpCommuncationDirectionConsuming] =
     g_network_status.udp_io_messaging;
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
 
   sock_addr_info->length = 16;
   sock_addr_info->type_id = kCipItemIdSocketAddressInfoOriginatorToTarget;
@@ -461,6 +558,27 @@ CipError OpenProducingPointToPointConnection(
   connection_object->remote_address.sin_addr.s_addr = GetPeerAddress();
   connection_object->remote_address.sin_port = port;
 
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+  /* the consuming socket is already connected to the originator's I/O port */
+  const int consuming_socket =
+    connection_object->socket[kUdpCommuncationDirectionConsuming];
+  if(kEipInvalidSocket != consuming_socket &&
+     ConnectionObjectGetOToTConnectionType(connection_object) ==
+     kConnectionObjectConnectionTypePointToPoint &&
+     connection_object->originator_address.sin_addr.s_addr ==
+     connection_object->remote_address.sin_addr.s_addr &&
+     connection_object->originator_address.sin_port ==
+     connection_object->remote_address.sin_port) {
+    connection_object->socket[kUdpCommuncationDirectionProducing] =
+      consuming_socket;
+    connection_object->producing_socket_is_connected = true;
+    return kCipErrorSuccess;
+  }
+  /* the originator receives on another port, the consuming socket would not
+   * get its datagrams anymore if it was connected to it */
+  CreateUdpSocket();
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
+
   CipUsint qos_for_socket = ConnectionObjectGetTToOPriority(connection_object);
   int error = SetQos(qos_for_socket);
   if (error != 0) {
@@ -725,8 +843,8 @@ static int transfer_master_connection(CipConnectionObject *connection_object) {
     connection_object->eip_level_sequence_count_producing;
   active->sequence_count_producing =
     connection_object->sequence_count_producing;
-  active->transmission_trigger_timer =
-    connection_object->transmission_trigger_timer;
+  ScheduleConnectionProduction(active,
+                               connection_object->transmission_trigger_timer.deadline);
 
   return 0;
 }
@@ -779,8 +897,8 @@ void HandleIoConnectionTimeOut(CipConnectionObject *connection_object) {
                          kIoConnectionEventTimedOut);
   ConnectionObjectSetState(connection_object, kConnectionObjectStateTimedOut);
 
-  if(connection_object->last_package_watchdog_timer ==
-     connection_object->inactivity_watchdog_timer) {
+  if(connection_object->last_package_watchdog_deadline ==
+     connection_object->inactivity_watchdog_deadline) {
     CheckForTimedOutConnectionsAndCloseTCPConnections(connection_object,
                                                       CloseEncapsulationSessionBySockAddr);
   }
@@ -820,15 +938,116 @@ void HandleIoConnectionTimeOut(CipConnectionObject *connection_object) {
   ConnectionObjectSetState(connection_object, kConnectionObjectStateTimedOut);
 }
 
+/** @brief Gets the snapshot of an assembly produced in the production batch
+ *
+ * The application is notified once per assembly and batch, the data is
+ * copied once for all connections producing the assembly. The snapshot is
+ * kept in the produced data buffer of the first of these connections.
+ * @param connection_object a connection producing the assembly
+ * @return the snapshot of the assembly
+ */
+static const ProducedAssembly *GetProducedAssembly(
+  const CipConnectionObject *const connection_object) {
+  CipInstance *const instance = connection_object->producing_instance;
+  for(size_t i = 0; i < s_number_of_produced_assemblies; i++) {
+    if(instance == s_produced_assemblies[i].instance) {
+      return &s_produced_assemblies[i];
+    }
+  }
+  /* a batch holds at most one assembly per message */
+  ProducedAssembly *const assembly =
+    &s_produced_assemblies[s_number_of_produced_assemblies++];
+  assembly->instance = instance;
+  /* notify the application that data will be sent immediately after the call */
+  assembly->data_changed = BeforeAssemblyDataSend(instance);
+  const CipByteArray *const data = instance->attributes->data;
+  assembly->length = 0;
+  assembly->data = NULL;
+  if(0 != data->length) {
+    /* the buffer is sized for the connection size, which covers the data */
+    OPENER_ASSERT(data->length <=
+                  connection_object->produced_data_buffer->capacity);
+    memcpy(connection_object->produced_data_buffer->data, data->data,
+           data->length);
+    assembly->length = data->length;
+    assembly->data = connection_object->produced_data_buffer->data;
+  }
+  return assembly;
+}
+
+/** @brief Assembles the message of a producing connection into a batch entry
+ *
+ *  @param connection_object The producing connection
+ *  @param entry The batch entry to be filled
+ */
+static void AssembleProductionBatchEntry(
+  CipConnectionObject *const connection_object,
+  UdpDataBatchEntry *const entry) {
+  InitializeENIPMessage(&entry->message);
+  /* all messages of an assembly in the batch send the same snapshot */
+  const ProducedAssembly *const assembly = GetProducedAssembly(
+    connection_object);
+  AssembleConnectedDataHeader(connection_object, assembly->data_changed,
+                              &entry->message);
+  entry->payload = assembly->data;
+  entry->payload_length = assembly->length;
+  entry->address = connection_object->remote_address;
+  entry->socket = kEipInvalidSocket;
+  if(connection_object->producing_socket_is_connected) {
+    entry->socket =
+      connection_object->socket[kUdpCommuncationDirectionProducing];
+  }
+#if defined(OPENER_IO_TIMESTAMPING)
+  entry->connection_id = connection_object->cip_produced_connection_id;
+  /* productions triggered before their timer expired are due now */
+  const MicroSeconds current_time = GetMicroSeconds();
+  const MicroSeconds deadline =
+    connection_object->transmission_trigger_timer.deadline;
+  entry->production_deadline =
+    (0 != deadline && deadline < current_time) ? deadline : current_time;
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+}
+
 EipStatus SendConnectedData(CipConnectionObject *connection_object) {
+  if(s_production_batch_active) {
+    if(OPENER_UDP_SEND_BATCH_SIZE == s_production_batch_length) {
+      FlushProductionBatch();
+    }
+    AssembleProductionBatchEntry(connection_object,
+                                 &s_production_batch[s_production_batch_length]);
+    s_production_batch_connection_ids[s_production_batch_length] =
+      connection_object->cip_produced_connection_id;
+    s_production_batch_length++;
+    return kEipStatusOk; /* errors are reported when the batch is sent */
+  }
 
-  /* TODO think of adding an own send buffer to each connection object in order to preset up the whole message on connection opening and just change the variable data items e.g., sequence number */
+  /* a batch of one sends the data from the buffer of the connection, which
+   * may exceed the message buffer */
+  UdpDataBatchEntry entry;
+  AssembleProductionBatchEntry(connection_object, &entry);
+  SendUdpDataBatch(&entry, 1);
+  s_number_of_produced_assemblies = 0;
+  return entry.send_status;
+}
+
+/** @brief Checks if the produced messages of a connection carry the run/idle
+ * header, heartbeats never do */
+static bool HasProducedRunIdleHeader(
+  const CipConnectionObject *const connection_object) {
+  const CipByteArray *const data =
+    connection_object->producing_instance->attributes->data;
+  return s_produce_run_idle && 0 != data->length;
+}
 
+/** @brief Builds the produced messages of a connection up to the data, the
+ * sequence numbers and the run/idle state are written per message
+ *
+ *  @param connection_object The producing connection
+ */
+static void BuildProducedMessageHeader(
+  CipConnectionObject *const connection_object) {
   CipCommonPacketFormatData *common_packet_format_data =
     &g_common_packet_format_data_item;
-  /* TODO think on adding a CPF data item to the S_CIP_ConnectionObject in order to remove the code here or even better allocate memory in the connection object for storing the message to send and just change the application data*/
-
-  connection_object->eip_level_sequence_count_producing++;
 
   /* assembleCPFData */
   common_packet_format_data->item_count = 2;
@@ -839,8 +1058,7 @@ EipStatus SendConnectedData(CipConnectionObject *connection_object) {
     common_packet_format_data->address_item.type_id =
       kCipItemIdSequencedAddressItem;
     common_packet_format_data->address_item.length = 8;
-    common_packet_format_data->address_item.data.sequence_number =
-      connection_object->eip_level_sequence_count_producing;
+    common_packet_format_data->address_item.data.sequence_number = 0;
   } else {
     common_packet_format_data->address_item.type_id =
       kCipItemIdConnectionAddress;
@@ -856,26 +1074,20 @@ EipStatus SendConnectedData(CipConnectionObject *connection_object) {
     (CipByteArray *) connection_object->producing_instance->attributes->data;
   common_packet_format_data->data_item.length = 0;
 
-  /* notify the application that data will be sent immediately after the call */
-  if( BeforeAssemblyDataSend(connection_object->producing_instance) ) {
-    /* the data has changed increase sequence counter */
-    connection_object->sequence_count_producing++;
-  }
-
   /* set AddressInfo Items to invalid Type */
   common_packet_format_data->address_info_item[0].type_id = 0;
   common_packet_format_data->address_info_item[1].type_id = 0;
 
-  ENIPMessage outgoing_message;
-  InitializeENIPMessage(&outgoing_message);
-  AssembleIOMessage(common_packet_format_data, &outgoing_message);
+  ENIPMessage header;
+  InitializeENIPMessage(&header);
+  AssembleIOMessage(common_packet_format_data, &header);
 
-  MoveMessageNOctets(-2, &outgoing_message);
+  MoveMessageNOctets(-2, &header);
   common_packet_format_data->data_item.length =
     producing_instance_attributes->length;
 
-  bool is_heartbeat = (common_packet_format_data->data_item.length == 0);
-  if(s_produce_run_idle && !is_heartbeat) {
+  const bool has_run_idle = HasProducedRunIdleHeader(connection_object);
+  if(has_run_idle) {
     common_packet_format_data->data_item.length += 4;
   }
 
@@ -883,30 +1095,88 @@ EipStatus SendConnectedData(CipConnectionObject *connection_object) {
       ConnectionObjectGetTransportClassTriggerTransportClass(connection_object) )
   {
     common_packet_format_data->data_item.length += 2;
-    AddIntToMessage(common_packet_format_data->data_item.length,
-                    &outgoing_message);
-    AddIntToMessage(connection_object->sequence_count_producing,
-                    &outgoing_message);
+    AddIntToMessage(common_packet_format_data->data_item.length, &header);
+    AddIntToMessage(0, &header);
   } else {
-    AddIntToMessage(common_packet_format_data->data_item.length,
-                    &outgoing_message);
+    AddIntToMessage(common_packet_format_data->data_item.length, &header);
   }
 
-  if(s_produce_run_idle && !is_heartbeat) {
-    AddDintToMessage( g_run_idle_state,
-                      &outgoing_message );
+  if(has_run_idle) {
+    AddDintToMessage(0, &header);
   }
 
-  memcpy(outgoing_message.current_message_position,
-         producing_instance_attributes->data,
-         producing_instance_attributes->length);
+  OPENER_ASSERT(header.used_message_length <=
+                CIP_PRODUCED_MESSAGE_HEADER_MAXIMUM_LENGTH);
+  memcpy(connection_object->produced_message_header, header.message_buffer,
+         header.used_message_length);
+  connection_object->produced_message_header_length =
+    (CipUsint) header.used_message_length;
+  connection_object->produced_message_header_has_run_idle = has_run_idle;
+}
 
-  outgoing_message.current_message_position +=
-    producing_instance_attributes->length;
-  outgoing_message.used_message_length += producing_instance_attributes->length;
+void AssembleConnectedDataHeader(CipConnectionObject *connection_object,
+                                 const bool data_changed,
+                                 ENIPMessage *const outgoing_message) {
+  /* the run/idle header may have been switched on or off by the application */
+  const bool has_run_idle = HasProducedRunIdleHeader(connection_object);
+  if(0 == connection_object->produced_message_header_length ||
+     has_run_idle != connection_object->produced_message_header_has_run_idle) {
+    BuildProducedMessageHeader(connection_object);
+  }
 
-  return SendUdpData(&connection_object->remote_address,
-                     &outgoing_message);
+  connection_object->eip_level_sequence_count_producing++;
+  if(data_changed) {
+    /* the data has changed increase sequence counter */
+    connection_object->sequence_count_producing++;
+  }
+
+  /* copy the built header and write the fields changing per message */
+  memcpy(outgoing_message->current_message_position,
+         connection_object->produced_message_header,
+         connection_object->produced_message_header_length);
+  const ConnectionObjectTransportClassTriggerTransportClass transport_class =
+    ConnectionObjectGetTransportClassTriggerTransportClass(connection_object);
+  MoveMessageNOctets(kProducedMessageConnectionIdEnd, outgoing_message);
+  if(kConnectionObjectTransportClassTriggerTransportClass0 !=
+     transport_class) {
+    AddDintToMessage(connection_object->eip_level_sequence_count_producing,
+                     outgoing_message);
+  }
+  MoveMessageNOctets(kProducedMessageDataItemHeaderLength, outgoing_message);
+  if(kConnectionObjectTransportClassTriggerTransportClass1 ==
+     transport_class) {
+    AddIntToMessage(connection_object->sequence_count_producing,
+                    outgoing_message);
+  }
+  if(has_run_idle) {
+    AddDintToMessage(g_run_idle_state, outgoing_message);
+  }
+}
+
+void BeginProductionBatch(void) {
+  s_production_batch_active = true;
+}
+
+void EndProductionBatch(void) {
+  FlushProductionBatch();
+  s_production_batch_active = false;
+}
+
+void FlushProductionBatch(void) {
+  if(0 == s_production_batch_length) {
+    return;
+  }
+  SendUdpDataBatch(s_production_batch, s_production_batch_length);
+  /* the snapshots are not referenced by any message anymore */
+  s_number_of_produced_assemblies = 0;
+  for(size_t i = 0; i < s_production_batch_length; i++) {
+    if(kEipStatusOk != s_production_batch[i].send_status) {
+      OPENER_TRACE_ERR(
+        "sending of UDP data for connection ID %u failed\n",
+        s_production_batch_connection_ids[i]);
+    }
+  }
+  s_production_batch_length = 0;
 }
 
 EipStatus HandleReceivedIoConnectionData(CipConnectionObject *connection_object,
@@ -951,11 +1221,20 @@ EipStatus HandleReceivedIoConnectionData(CipConnectionObject *connection_object,
       return kEipStatusOk;
     }
 
+#ifdef OPENER_CONSUMED_DATA_ZERO_COPY
+    if(NotifyAssemblyConnectedDataReferenced(connection_object->
+                                             consuming_instance,
+                                             data,
+                                             data_length) != 0) {
+      return kEipStatusError;
+    }
+#else
     if(NotifyAssemblyConnectedDataReceived(connection_object->consuming_instance,
                                            (EipUint8 *const ) data,
                                            data_length) != 0) {
       return kEipStatusError;
     }
+#endif
   }
   return kEipStatusOk;
 }
@@ -963,7 +1242,6 @@ EipStatus HandleReceivedIoConnectionData(CipConnectionObject *connection_object,
 CipError OpenCommunicationChannels(CipConnectionObject *connection_object) {
 
   CipError cip_error = kCipErrorSuccess;
-  CreateUdpSocket(); /* open UDP socket for IO messaging*/
 
 /*get pointer to the CPF data, currently we have just one global instance of the struct. This may change in the future*/
   CipCommonPacketFormatData *common_packet_format_data =
@@ -975,6 +1253,18 @@ CipError OpenCommunicationChannels(CipConnectionObject *connection_object) {
   ConnectionObjectConnectionType target_to_originator_connection_type =
     ConnectionObjectGetTToOConnectionType(connection_object);
 
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+  /* point to point connections open connected sockets of their own */
+  if(kConnectionObjectConnectionTypeMulticast ==
+     originator_to_target_connection_type ||
+     kConnectionObjectConnectionTypeMulticast ==
+     target_to_originator_connection_type) {
+    CreateUdpSocket();
+  }
+#else
+  CreateUdpSocket(); /* open UDP socket for IO messaging*/
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
+
   /* open a connection "point to point" or "multicast" based on the ConnectionParameter */
   if(originator_to_target_connection_type ==
      kConnectionObjectConnectionTypeMulticast)
@@ -1023,20 +1313,92 @@ CipError OpenCommunicationChannels(CipConnectionObject *connection_object) {
   return cip_error;
 }
 
-void CloseCommunicationChannelsAndRemoveFromActiveConnectionsList(
-  CipConnectionObject *connection_object) {
+/** @brief Closes the UDP sockets of an I/O connection */
+static void CloseCommunicationChannels(
+  CipConnectionObject *const connection_object) {
   if(kEipInvalidSocket !=
      connection_object->socket[kUdpCommuncationDirectionConsuming]) {
     CloseUdpSocket(connection_object->socket[kUdpCommuncationDirectionConsuming]);
   }
 
+  /* both directions may share one socket */
   if(kEipInvalidSocket !=
+     connection_object->socket[kUdpCommuncationDirectionProducing] &&
+     connection_object->socket[kUdpCommuncationDirectionConsuming] !=
      connection_object->socket[kUdpCommuncationDirectionProducing]) {
     CloseUdpSocket(connection_object->socket[kUdpCommuncationDirectionProducing]);
   }
+}
 
+void CloseCommunicationChannelsAndRemoveFromActiveConnectionsList(
+  CipConnectionObject *connection_object) {
+  /* a watchdog timeout handled while producing may close connections whose
+   * messages are batched, these use their sockets and the snapshots in their
+   * produced data buffers */
+  FlushProductionBatch();
+  CloseCommunicationChannels(connection_object);
   RemoveFromActiveConnections(connection_object);
+  MessageBufferPoolRelease(&s_produced_data_pool,
+                           connection_object->produced_data_buffer);
   ConnectionObjectInitializeEmpty(connection_object);
   OPENER_TRACE_INFO(
     "cipioconnection: CloseCommunicationChannelsAndRemoveFromActiveConnectionsList\n");
 }
+
+void FreeIoConnectionMessageBuffers(void) {
+  MessageBufferPoolDestroy(&s_produced_data_pool);
+}
+
+#if defined(OPENER_IO_TIMESTAMPING)
+void SetConnectedDataReceiveTime(const MicroSeconds receive_time) {
+  s_connected_data_receive_time = receive_time;
+}
+
+void IoConnectionRecordReception(
+  CipConnectionObject *const connection_object) {
+  const MicroSeconds receive_time = s_connected_data_receive_time;
+  if(0 == receive_time) {
+    return;
+  }
+  const MicroSeconds current_time = GetMicroSeconds();
+  LatencyHistogramAdd(&connection_object->latency.consumption_latency,
+                      current_time > receive_time ?
+                      current_time - receive_time : 0);
+
+  const MicroSeconds last_receive_time = connection_object->last_receive_time;
+  if(0 != last_receive_time && receive_time > last_receive_time) {
+    const MicroSeconds interval = receive_time - last_receive_time;
+    const MicroSeconds requested_packet_interval =
+      ConnectionObjectGetOToTRequestedPacketInterval(connection_object);
+    LatencyHistogramAdd(&connection_object->latency.consumption_jitter,
+                        interval > requested_packet_interval ?
+                        interval - requested_packet_interval :
+                        requested_packet_interval - interval);
+  }
+  connection_object->last_receive_time = receive_time;
+}
+
+void HandleTransmittedConnectedData(const CipUdint produced_connection_id,
+                                    const MicroSeconds production_deadline,
+                                    const MicroSeconds transmit_time) {
+  /* connections sharing a multicast production only count at the producer */
+  CipConnectionObject *const connection_object = GetProducingConnection(
+    produced_connection_id);
+  if(NULL != connection_object) {
+    LatencyHistogramAdd(&connection_object->latency.production_lateness,
+                        transmit_time > production_deadline ?
+                        transmit_time - production_deadline : 0);
+  }
+}
+
+EipStatus GetIoConnectionLatency(const CipUdint consumed_connection_id,
+                                 IoConnectionLatency *const latency) {
+  const CipConnectionObject *const connection_object = GetConnectedObject(
+    consumed_connection_id);
+  if(NULL == connection_object) {
+    return kEipStatusError;
+  }
+  *latency = connection_object->latency;
+  return kEipStatusOk;
+}
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
@@ -75,6 +75,36 @@ CipError OpenCommunicationChannels(CipConnectionObject *connection_object);
 void CloseCommunicationChannelsAndRemoveFromActiveConnectionsList(
   CipConnectionObject *connection_object);
 
+/** @brief Frees the buffers of the producing connections
+ *
+ * The buffers are taken from a pool when a connection is opened and returned
+ * when it is closed, so the pool only grows to the connections open at the
+ * same time. Called when the connections are shut down.
+ */
+void FreeIoConnectionMessageBuffers(void);
+
+/** @brief Starts collecting the data of producing connections
+ *
+ * Until EndProductionBatch() is called SendConnectedData() only assembles the
+ * message into a pooled batch, which is sent with SendUdpDataBatch() when it is
+ * full or the batch is ended.
+ */
+void BeginProductionBatch(void);
+
+/** @brief Sends the collected data of producing connections and returns to
+ * sending immediately
+ */
+void EndProductionBatch(void);
+
+#if defined(OPENER_IO_TIMESTAMPING)
+/** @brief Adds the reception time set by SetConnectedDataReceiveTime() to the
+ * consumption latencies of a connection
+ *
+ * @param connection_object The connection having accepted the received data
+ */
+void IoConnectionRecordReception(CipConnectionObject *const connection_object);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+
 extern EipUint8 *g_config_data_buffer;
 extern unsigned int g_config_data_length;
 
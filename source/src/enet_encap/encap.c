@@ -20,7 +20,6 @@
 #include "ciptcpipinterface.h"
 #include "generic_networkhandler.h"
 #include "trace.h"
-#include "socket_timer.h"
 #include "opener_error.h"
 
 /* IP address data taken from TCPIPInterfaceObject*/
@@ -462,10 +461,7 @@ void HandleReceivedRegisterSessionCommand(int socket, const EncapsulationData *c
       {
         encapsulation_protocol_status = kEncapsulationProtocolInsufficientMemory;
       } else { /* successful session registered */
-        SocketTimer *socket_timer = SocketTimerArrayGetEmptySocketTimer(g_timestamps,
-        OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
-        SocketTimerSetSocket(socket_timer, socket);
-        SocketTimerSetLastUpdate(socket_timer, g_actual_time);
+        AddSocketTimerToList(socket);
         g_registered_sessions[session_index] = socket; /* store associated socket */
         session_handle = (CipSessionHandle)(session_index + 1);
         encapsulation_protocol_status = kEncapsulationProtocolSuccess;
@@ -730,10 +726,10 @@ void CloseClass3ConnectionBasedOnSession(CipSessionHandle encapsulation_session_
   DoublyLinkedListNode *node = connection_list.first;
   while(NULL != node) {
     CipConnectionObject *connection_object = node->data;
+    node = node->next; /* closing the connection frees its node */
     if(kConnectionObjectTransportClassTriggerTransportClass3 == ConnectionObjectGetTransportClassTriggerTransportClass(connection_object)
       && connection_object->associated_encapsulation_session == encapsulation_session_handle) {
       connection_object->connection_close_function(connection_object);
     }
-    node = node->next;
   }
 }
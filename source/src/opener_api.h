@@ -12,6 +12,9 @@
 #include "typedefs.h"
 #include "ciptypes.h"
 #include "ciperror.h"
+#if defined(OPENER_IO_TIMESTAMPING)
+#include "latencyhistogram.h"
+#endif
 
 #if defined(STM32)	/** STM32 target -> uses a struct for the network interface */
 #define TcpIpInterface struct netif
@@ -661,12 +664,45 @@ EipStatus
 AddConnectableObject(const CipUdint class_code,
                      OpenConnectionFunction open_connection_function);
 
+/** @brief Numbers of connections the connection manager can hold
+ *
+ * The connection objects are allocated on the start of the stack, the
+ * defaults are the OPENER_CIP_NUM_* values of opener_user_conf.h.
+ */
+typedef struct {
+  size_t explicit_connections; /**< explicit messaging connections */
+  size_t exclusive_owner_connection_points; /**< exclusive owner connection points, one connection each */
+  size_t input_only_connection_points; /**< input only connection points */
+  size_t input_only_connections_per_point; /**< connections per input only connection point */
+  size_t listen_only_connection_points; /**< listen only connection points */
+  size_t listen_only_connections_per_point; /**< connections per listen only connection point */
+} ConnectionCapacity;
+
+/** @ingroup CIP_API
+ * @brief Sets the numbers of connections the stack allocates
+ *
+ * Lets one build serve as small adapter or as gateway with many connections.
+ * Has to be called before CipStackInit() or after ShutdownCipStack().
+ *
+ * @param capacity The numbers of connections
+ * @return kEipStatusOk on success, kEipStatusError if the connections are
+ *  already allocated
+ */
+EipStatus SetConnectionCapacity(const ConnectionCapacity *const capacity);
+
+/** @ingroup CIP_API
+ * @brief Gets the numbers of connections the stack allocates
+ *
+ * @return The numbers of connections
+ */
+const ConnectionCapacity *GetConnectionCapacity(void);
+
 /** @ingroup CIP_API
  * @brief Configures the connection point for an exclusive owner connection.
  *
  * @param connection_number The number of the exclusive owner connection. The
- *        enumeration starts with 0. Has to be smaller than
- *        OPENER_CIP_NUM_EXLUSIVE_OWNER_CONNS.
+ *        enumeration starts with 0. Has to be smaller than the
+ *        exclusive_owner_connection_points of the connection capacity.
  * @param output_assembly_id ID of the O-to-T point to be used for this
  * connection
  * @param input_assembly_id ID of the T-to-O point to be used for this
@@ -684,8 +720,8 @@ void ConfigureExclusiveOwnerConnectionPoint(
  * @brief Configures the connection point for an input only connection.
  *
  * @param connection_number The number of the input only connection. The
- *        enumeration starts with 0. Has to be smaller than
- *        OPENER_CIP_NUM_INPUT_ONLY_CONNS.
+ *        enumeration starts with 0. Has to be smaller than the
+ *        input_only_connection_points of the connection capacity.
  * @param output_assembly_id ID of the O-to-T point to be used for this
  * connection
  * @param input_assembly_id ID of the T-to-O point to be used for this
@@ -702,8 +738,8 @@ void ConfigureInputOnlyConnectionPoint(const unsigned int connection_number,
  * \brief Configures the connection point for a listen only connection.
  *
  * @param connection_number The number of the input only connection. The
- *        enumeration starts with 0. Has to be smaller than
- *        OPENER_CIP_NUM_LISTEN_ONLY_CONNS.
+ *        enumeration starts with 0. Has to be smaller than the
+ *        listen_only_connection_points of the connection capacity.
  * @param output_assembly_id ID of the O-to-T point to be used for this
  * connection
  * @param input_assembly_id ID of the T-to-O point to be used for this
@@ -716,6 +752,56 @@ void ConfigureListenOnlyConnectionPoint(const unsigned int connection_number,
                                         const unsigned int input_assembly_id,
                                         const unsigned int configuration_assembly_id);
 
+/** @brief Production phase of connection points spreading their productions
+ * automatically */
+static const CipUint kProductionPhaseAutomatic = 0xFFFFU;
+
+/** @brief Resolution of the production phase, the phase is given in parts of
+ * the RPI */
+static const CipUint kProductionPhaseResolution = 1000U;
+
+/** @ingroup CIP_API
+ * @brief Configures the phase of the productions of the connections producing
+ * an input assembly
+ *
+ * By default a new connection producing an assembly already produced with
+ * its RPI shares the phase of that production, so the assembly is produced
+ * once per cycle for all its consumers. Otherwise its first production is
+ * placed in the middle of the largest gap between the productions of the
+ * connections with the same RPI, so different assemblies with equal RPIs are
+ * not produced in the same cycle. A
+ * configured phase places the productions at a fixed offset within the RPI
+ * instead, e.g. to keep the productions of an assembly clear of other traffic.
+ * Has to be called after the connection points of the input assembly have
+ * been configured.
+ *
+ * @param input_assembly_id ID of the T-to-O point of the connection points
+ * @param phase Offset of the productions in 1/kProductionPhaseResolution of
+ * the RPI, kProductionPhaseAutomatic to spread the productions automatically
+ * @return kEipStatusOk on success, kEipStatusError if the phase is out of range
+ * or no connection point produces the input assembly
+ */
+EipStatus ConfigureProductionPhase(const unsigned int input_assembly_id,
+                                   const CipUint phase);
+
+/** @brief Statistics of the productions of the connection timers
+ *
+ *  A cycle is a call of ManageConnectionTimers() producing at least one
+ *  message. Spread productions keep the number of messages per cycle low.
+ */
+typedef struct {
+  CipUdint production_cycles; /**< cycles producing messages */
+  CipUdint productions; /**< messages produced in all cycles */
+  CipUdint max_productions_per_cycle; /**< most messages produced in one cycle */
+} ProductionStatistics;
+
+/** @ingroup CIP_API
+ * @brief Gets the statistics of the productions since the start of the stack
+ *
+ * @return the production statistics
+ */
+const ProductionStatistics *GetProductionStatistics(void);
+
 /** @ingroup CIP_API
  * @brief Notify the encapsulation layer that an explicit message has been
  * received via TCP.
@@ -777,13 +863,13 @@ EipStatus HandleReceivedConnectedData(const EipUint8 *const received_data,
                                       struct sockaddr_in *from_address);
 
 /** @ingroup CIP_API
- * @brief Check if any of the connection timers (TransmissionTrigger or
- * WatchdogTimeout) have timed out.
+ * @brief Give the application and the encapsulation layer the possibility to
+ * execute their periodic tasks.
  *
- * If the a timeout occurs the function performs the necessary action. This
- * function should be called periodically once every @ref kOpenerTimerTickInMilliSeconds
+ * This function should be called periodically once every @ref kOpenerTimerTickInMilliSeconds
  * milliseconds. In order to simplify the algorithm if more time was lapsed, the elapsed
- * time since the last call of the function is given as a parameter.
+ * time since the last call of the function is given as a parameter. The
+ * connection timers are handled by ManageConnectionTimers().
  *
  * @param elapsed_time Elapsed time in milliseconds since the last call of ManageConnections
  *
@@ -792,17 +878,94 @@ EipStatus HandleReceivedConnectedData(const EipUint8 *const received_data,
 EipStatus ManageConnections(MilliSeconds elapsed_time);
 
 /** @ingroup CIP_API
- * @brief Trigger the production of an application triggered connection.
+ * @brief Handle the connection timers (TransmissionTrigger or
+ * WatchdogTimeout) which have expired.
+ *
+ * The timers are kept ordered by their expiry, only the expired ones are
+ * handled. The function should be called on every cycle of the network
+ * handler, which should not wait longer for network events than given by
+ * GetTimeToNextConnectionTimer().
+ *
+ * @param current_time Current time in microseconds, monotonic
+ */
+void ManageConnectionTimers(const MicroSeconds current_time);
+
+/** @ingroup CIP_API
+ * @brief Get the time until the next connection timer expires
+ *
+ * @param current_time Current time in microseconds
+ * @param max_time Maximum time to be returned in microseconds
+ * @return time until the next expiry in microseconds, max_time if no timer
+ * expires earlier
+ */
+MicroSeconds GetTimeToNextConnectionTimer(const MicroSeconds current_time,
+                                          const MicroSeconds max_time);
+
+#if defined(OPENER_IO_TIMESTAMPING)
+/** @brief Latencies of an implicit IO connection, measured with the transmit
+ * and receive timestamps of the network stack
+ */
+typedef struct {
+  LatencyHistogram production_lateness; /**< time from the production deadline
+                                           until the message left */
+  LatencyHistogram consumption_jitter; /**< deviation of the interval between
+                                          two received messages from the O->T
+                                          RPI */
+  LatencyHistogram consumption_latency; /**< time from the reception of a
+                                           message until it was handled */
+} IoConnectionLatency;
+
+/** @ingroup CIP_API
+ * @brief Notify the connection manager about the reception time of the
+ * datagram next passed to HandleReceivedConnectedData().
+ *
+ * @param receive_time Time the datagram was received in microseconds on the
+ *  time base of GetMicroSeconds(), 0 if unknown
+ */
+void SetConnectedDataReceiveTime(const MicroSeconds receive_time);
+
+/** @ingroup CIP_API
+ * @brief Notify the connection manager that a produced message has been
+ * sent.
  *
- * This will issue the production of the specified connection at the next
- * possible occasion. Depending on the values for the RPI and the production
- * inhibit timer. The application is informed via the
+ * This function should be invoked by the network layer once the transmit
+ * timestamp of the message is known.
+ * @param produced_connection_id The T->O connection ID of the message
+ * @param production_deadline Time the message was due
+ * @param transmit_time Time the message was sent, on the time base of
+ *  GetMicroSeconds()
+ */
+void HandleTransmittedConnectedData(const CipUdint produced_connection_id,
+                                    const MicroSeconds production_deadline,
+                                    const MicroSeconds transmit_time);
+
+/** @ingroup CIP_API
+ * @brief Get the measured latencies of an implicit IO connection
+ *
+ * @param consumed_connection_id The O->T connection ID of the connection
+ * @param latency Returns a copy of the latency histograms
+ * @return kEipStatusOk, kEipStatusError if no connection consumes the ID
+ */
+EipStatus GetIoConnectionLatency(const CipUdint consumed_connection_id,
+                                 IoConnectionLatency *const latency);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+
+/** @ingroup CIP_API
+ * @brief Trigger the production of an application triggered or change of
+ * state connection.
+ *
+ * If the production inhibit time of the connection has expired the data is
+ * produced right away from the context of the caller, otherwise it is
+ * produced as soon as the production inhibit time expires. The next
+ * production without a trigger follows one RPI later. The application is
+ * informed via the
  * EIP_BOOL8 BeforeAssemblyDataSend(S_CIP_Instance *pa_pstInstance)
  * callback function when the production will happen. This function should only
- * be invoked from void HandleApplication(void).
+ * be invoked from void HandleApplication(void) or the other callback
+ * functions of the application.
  *
  * The connection can only be triggered if the application is established and it
- * is of application application triggered type.
+ * is of application triggered or change of state type.
  *
  * @param output_assembly_id the output assembly connection point of the
  * connection
@@ -964,6 +1127,95 @@ int CreateUdpSocket(void);
 EipStatus SendUdpData(const struct sockaddr_in *const socket_data,
                       const ENIPMessage *const outgoing_message);
 
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+/** @ingroup CIP_CALLBACK_API
+ * @brief Create a UDP socket for the implicit IO messaging of one point to
+ * point connection
+ *
+ * The socket is bound to the IO messaging port and connected to the peer, so
+ * the network stack delivers the datagrams of the peer to this socket.
+ * @param peer_address Address of the peer
+ * @param qos_for_socket QoS value of the connection
+ * @return the socket handle if successful, else kEipInvalidSocket
+ */
+int CreateConnectedUdpSocket(const struct sockaddr_in *const peer_address,
+                             const CipUsint qos_for_socket);
+
+/** @ingroup CIP_CALLBACK_API
+ * @brief Sends the data for the implicit IO messaging via a connected UDP
+ * socket
+ * @param socket Socket created by CreateConnectedUdpSocket()
+ * @param outgoing_message The constructed outgoing message
+ * @return kEipStatusOk on success
+ */
+EipStatus SendConnectedUdpData(const int socket,
+                               const ENIPMessage *const outgoing_message);
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
+
+#if defined(OPENER_IO_SOCKET_FILTER)
+/** @ingroup CIP_CALLBACK_API
+ * @brief Updates the kernel filter of the implicit IO messaging sockets after
+ * a connection was added to or removed from the active connections
+ *
+ * Datagrams that do not carry the consumed connection ID of an active
+ * connection from its originator are dropped before reaching the stack.
+ */
+void UpdateIoSocketFilter(void);
+#endif /* defined(OPENER_IO_SOCKET_FILTER) */
+
+/** @ingroup CIP_CALLBACK_API
+ * @brief Reports that the first active connection consumes from a UDP socket
+ *
+ * A port receiving the implicit IO messages on a thread of its own watches
+ * exactly the sockets consumed from by the active connections.
+ * @param socket The consuming socket
+ */
+void AddConsumingUdpSocket(const int socket);
+
+/** @ingroup CIP_CALLBACK_API
+ * @brief Reports that no active connection consumes from a UDP socket anymore
+ *
+ * @param socket The consuming socket
+ */
+void RemoveConsumingUdpSocket(const int socket);
+
+/** @brief Maximum number of implicit IO messages sent as one batch */
+#ifndef OPENER_UDP_SEND_BATCH_SIZE
+  #define OPENER_UDP_SEND_BATCH_SIZE 16
+#endif
+
+/** @brief One message of a batch for the implicit IO messaging */
+typedef struct {
+  struct sockaddr_in address; /**< destination of the message */
+  int socket; /**< connected socket to send on, kEipInvalidSocket to send to
+                 address on the shared socket */
+  ENIPMessage message; /**< the constructed outgoing message */
+  const EipUint8 *payload; /**< data sent after the message without copying
+                              it into the message, NULL for none */
+  size_t payload_length; /**< length of the payload */
+  EipStatus send_status; /**< result of the send, set by SendUdpDataBatch() */
+#if defined(OPENER_IO_TIMESTAMPING)
+  CipUdint connection_id; /**< produced connection ID, reported with the
+                             transmit time */
+  MicroSeconds production_deadline; /**< time the message was due */
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+} UdpDataBatchEntry;
+
+/** @ingroup CIP_CALLBACK_API
+ * @brief Sends several messages for the implicit IO messaging via UDP socket
+ *
+ * Where supported the messages are handed to the network stack with a single
+ * system call, the result is reported for each message separately. Payloads
+ * shared by several messages have to stay unchanged until the call returns.
+ * Payloads may exceed the message buffer, where the messages cannot be
+ * gathered from the message and payload both have to fit into the message
+ * buffer.
+ * @param batch The messages to be sent
+ * @param number_of_messages Number of messages in batch
+ */
+void SendUdpDataBatch(UdpDataBatchEntry *const batch,
+                      const size_t number_of_messages);
+
 /** @ingroup CIP_CALLBACK_API
  * @brief Close the given socket and clean up the stack
  *
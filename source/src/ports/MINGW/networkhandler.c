@@ -14,7 +14,7 @@
 
 #include "generic_networkhandler.h"
 
-MicroSeconds getMicroSeconds() {
+MicroSeconds GetMicroSeconds(void) {
   LARGE_INTEGER performance_counter;
   LARGE_INTEGER performance_frequency;
 
@@ -26,7 +26,7 @@ MicroSeconds getMicroSeconds() {
 }
 
 MilliSeconds GetMilliSeconds(void) {
-  return (MilliSeconds) (getMicroSeconds() / 1000ULL);
+  return (MilliSeconds) (GetMicroSeconds() / 1000ULL);
 }
 
 EipStatus NetworkHandlerInitializePlatform(void) {
@@ -63,3 +63,12 @@ int SetQosOnSocket(int socket,
                     (char *)&set_tos,
                     sizeof(set_tos) );
 }
+
+int SetBusyPollOnSocket(const int socket,
+                        const MicroSeconds busy_poll_time) {
+  /* Suppress unused parameter compiler warning. */
+  (void) socket;
+  (void) busy_poll_time;
+
+  return 0; // Busy polling is not supported on this platform
+}
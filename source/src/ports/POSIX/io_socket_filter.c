@@ -0,0 +1,111 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <sys/socket.h>
+#include <netinet/udp.h>
+#include <arpa/inet.h>
+
+#include "io_socket_filter.h"
+
+#include "opener_error.h"
+#include "trace.h"
+
+/** @brief Offset of the connection ID of the address item, the filter sees
+ *  the datagram starting with the UDP header
+ *
+ *  Item count, type ID and length of the address item precede it.
+ */
+static const CipUdint kIoSocketFilterConnectionIdOffset =
+  sizeof(struct udphdr) + 6;
+
+/** @brief Offset of the source address in the IP header */
+static const CipUdint kIoSocketFilterSourceAddressOffset =
+  (CipUdint) (SKF_NET_OFF + 12);
+
+/** @brief Filter return value to pass the whole datagram */
+static const CipUdint kIoSocketFilterAccept = 0xFFFFFFFFU;
+
+static void LoadConnectionId(struct sock_filter *const instruction) {
+  *instruction = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+                                               kIoSocketFilterConnectionIdOffset);
+}
+
+void IoSocketFilterClear(IoSocketFilter *const filter) {
+  filter->number_of_connections = 0;
+  filter->accept_all = false;
+  LoadConnectionId(&filter->program[0]);
+}
+
+void IoSocketFilterAddConnection(IoSocketFilter *const filter,
+                                 const CipUdint connection_id,
+                                 const in_addr_t originator_address) {
+  if(OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS <=
+     filter->number_of_connections) {
+    filter->accept_all = true;
+    return;
+  }
+  /* the filter loads words in network byte order, the connection ID is sent
+   * in little endian */
+  const CipUdint loaded_connection_id =
+    ( (connection_id & 0x000000FFU) << 24 ) |
+    ( (connection_id & 0x0000FF00U) << 8 ) |
+    ( (connection_id & 0x00FF0000U) >> 8 ) |
+    ( (connection_id & 0xFF000000U) >> 24 );
+  /* skips the address check for connections accepted from any address */
+  const CipUsint address_check_length =
+    (htonl(INADDR_ANY) == originator_address) ? 2 : 0;
+
+  struct sock_filter *const instructions =
+    &filter->program[1 + filter->number_of_connections *
+                     IO_SOCKET_FILTER_INSTRUCTIONS_PER_CONNECTION];
+  instructions[0] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                                                  loaded_connection_id,
+                                                  address_check_length,
+                                                  4);
+  instructions[1] = (struct sock_filter) BPF_STMT(BPF_LD | BPF_W | BPF_ABS,
+                                                  kIoSocketFilterSourceAddressOffset);
+  instructions[2] = (struct sock_filter) BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K,
+                                                  ntohl(originator_address),
+                                                  0,
+                                                  1);
+  instructions[3] = (struct sock_filter) BPF_STMT(BPF_RET | BPF_K,
+                                                  kIoSocketFilterAccept);
+  /* the connection ID may be used by another originator */
+  LoadConnectionId(&instructions[4]);
+  filter->number_of_connections++;
+}
+
+EipStatus IoSocketFilterAttach(IoSocketFilter *const filter,
+                               const int socket) {
+  struct sock_filter accept_all_program =
+    BPF_STMT(BPF_RET | BPF_K, kIoSocketFilterAccept);
+  struct sock_fprog program = {
+    .len = 1,
+    .filter = &accept_all_program
+  };
+  if(!filter->accept_all) {
+    const size_t drop_index = 1 + filter->number_of_connections *
+                              IO_SOCKET_FILTER_INSTRUCTIONS_PER_CONNECTION;
+    filter->program[drop_index] =
+      (struct sock_filter) BPF_STMT(BPF_RET | BPF_K, 0);
+    program.len = (unsigned short) (drop_index + 1);
+    program.filter = filter->program;
+  }
+
+  if(0 > setsockopt(socket, SOL_SOCKET, SO_ATTACH_FILTER, &program,
+                    sizeof(program) ) ) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR(
+      "io socket filter: could not attach the filter to socket %d: %d - %s\n",
+      socket,
+      error_code,
+      error_message);
+    FreeErrorMessage(error_message);
+    return kEipStatusError;
+  }
+  return kEipStatusOk;
+}
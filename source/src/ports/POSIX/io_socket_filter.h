@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#ifndef SRC_PORTS_POSIX_IO_SOCKET_FILTER_H_
+#define SRC_PORTS_POSIX_IO_SOCKET_FILTER_H_
+
+/** @file io_socket_filter.h
+ *  @brief Socket filter that drops implicit I/O datagrams of unknown
+ *  connections in the kernel
+ *
+ *  The filter is a classic BPF program that compares the connection ID of the
+ *  address item and the source address of each datagram with the consuming
+ *  connections. Datagrams of no connection are dropped before they are copied
+ *  to user space.
+ */
+
+#include <stdbool.h>
+#include <netinet/in.h>
+#include <linux/filter.h>
+
+#include "typedefs.h"
+
+/** @brief Maximum number of connections the socket filter checks
+ *
+ *  With more consuming connections the filter accepts all datagrams and the
+ *  connections are looked up in user space only.
+ */
+#ifndef OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS
+  #define OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS 64
+#endif
+
+/** @brief Number of filter instructions needed to check one connection */
+#define IO_SOCKET_FILTER_INSTRUCTIONS_PER_CONNECTION 5
+
+/** @brief Size of the filter program, the connections are checked between
+ *  loading the connection ID and dropping the datagram */
+#define IO_SOCKET_FILTER_PROGRAM_SIZE (IO_SOCKET_FILTER_INSTRUCTIONS_PER_CONNECTION \
+                                       * OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS + 2)
+
+#if IO_SOCKET_FILTER_PROGRAM_SIZE > BPF_MAXINSNS
+  #error OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS exceeds the BPF program size
+#endif
+
+/** @brief Socket filter program for the implicit I/O sockets */
+typedef struct io_socket_filter {
+  size_t number_of_connections; /**< connections checked by the program */
+  bool accept_all; /**< more connections than the program can check */
+  struct sock_filter program[IO_SOCKET_FILTER_PROGRAM_SIZE]; /**< the filter instructions */
+} IoSocketFilter;
+
+/** @brief
+ * Removes all connections from the socket filter
+ *
+ * @param filter The socket filter
+ */
+void IoSocketFilterClear(IoSocketFilter *const filter);
+
+/** @brief
+ * Lets the datagrams of a consuming connection pass the socket filter
+ *
+ * @param filter The socket filter
+ * @param connection_id The consumed connection ID
+ * @param originator_address Address of the originator in network byte order,
+ *  INADDR_ANY to accept the connection ID from any address
+ */
+void IoSocketFilterAddConnection(IoSocketFilter *const filter,
+                                 const CipUdint connection_id,
+                                 const in_addr_t originator_address);
+
+/** @brief
+ * Attaches the socket filter to a UDP socket, replacing its previous filter
+ *
+ * @param filter The socket filter
+ * @param socket The UDP socket receiving implicit I/O datagrams
+ * @return kEipStatusOk on success, kEipStatusError otherwise
+ */
+EipStatus IoSocketFilterAttach(IoSocketFilter *const filter,
+                               const int socket);
+
+#endif /* SRC_PORTS_POSIX_IO_SOCKET_FILTER_H_ */
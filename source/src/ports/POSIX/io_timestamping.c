@@ -0,0 +1,247 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <netinet/in.h>
+#include <linux/net_tstamp.h>
+
+#include "io_timestamping.h"
+
+#include "opener_error.h"
+#include "trace.h"
+
+/** @brief A socket with timestamps */
+typedef struct {
+  int socket; /**< the socket, kEipInvalidSocket for an unused entry */
+  CipUdint next_key; /**< number the kernel gives the next sent datagram */
+  size_t sent_messages; /**< noted datagrams waiting for their timestamp */
+} IoTimestampingSocket;
+
+/** @brief A datagram waiting for its transmit timestamp */
+typedef struct {
+  IoTimestampingSocket *socket; /**< socket sent on, NULL for an unused entry */
+  CipUdint key; /**< number the kernel gave the datagram */
+  CipUdint connection_id; /**< produced connection ID */
+  MicroSeconds production_deadline; /**< time the datagram was due */
+} IoTimestampingSentMessage;
+
+static IoTimestampingSocket s_sockets[OPENER_IO_TIMESTAMPING_MAX_SOCKETS];
+
+/** @brief Ring of the sent messages, in the order of sending */
+static IoTimestampingSentMessage
+  s_sent_messages[OPENER_IO_TIMESTAMPING_MAX_SENT_MESSAGES];
+
+/** @brief Entry of s_sent_messages taking the next sent message */
+static size_t s_next_sent_message = 0;
+
+/** @brief Timestamps of sent and received datagrams, numbered per socket,
+ *  without the datagram in the error queue */
+static const int kIoTimestampingFlags = SOF_TIMESTAMPING_TX_SOFTWARE |
+                                        SOF_TIMESTAMPING_RX_SOFTWARE |
+                                        SOF_TIMESTAMPING_SOFTWARE |
+                                        SOF_TIMESTAMPING_TX_HARDWARE |
+                                        SOF_TIMESTAMPING_RX_HARDWARE |
+                                        SOF_TIMESTAMPING_RAW_HARDWARE |
+                                        SOF_TIMESTAMPING_OPT_ID |
+                                        SOF_TIMESTAMPING_OPT_TSONLY;
+
+static IoTimestampingSocket *FindSocket(const int socket) {
+  for(size_t i = 0; i < OPENER_IO_TIMESTAMPING_MAX_SOCKETS; i++) {
+    if(socket == s_sockets[i].socket) {
+      return &s_sockets[i];
+    }
+  }
+  return NULL;
+}
+
+static void RemoveSentMessage(IoTimestampingSentMessage *const sent_message) {
+  if(NULL != sent_message->socket) {
+    sent_message->socket->sent_messages--;
+    sent_message->socket = NULL;
+  }
+}
+
+/** @brief Converts a timestamp of the system clock to the time base of
+ *  GetMicroSeconds() */
+static MicroSeconds ToMicroSeconds(const struct timespec *const timestamp) {
+  struct timespec realtime;
+  struct timespec monotonic;
+  clock_gettime(CLOCK_REALTIME, &realtime);
+  clock_gettime(CLOCK_MONOTONIC, &monotonic);
+  const int64_t kNanoSecondsPerSecond = 1000000000LL;
+  const int64_t clock_offset =
+    (realtime.tv_sec - monotonic.tv_sec) * kNanoSecondsPerSecond +
+    (realtime.tv_nsec - monotonic.tv_nsec);
+  const int64_t monotonic_time =
+    timestamp->tv_sec * kNanoSecondsPerSecond + timestamp->tv_nsec -
+    clock_offset;
+  return 0 < monotonic_time ? (MicroSeconds) (monotonic_time / 1000) : 0;
+}
+
+/** @brief Gets the time of the hardware timestamp if there is one, of the
+ *  software timestamp otherwise */
+static MicroSeconds GetTimestamp(
+  const struct scm_timestamping *const timestamps) {
+  const struct timespec *const hardware = &timestamps->ts[2];
+  if(0 != hardware->tv_sec || 0 != hardware->tv_nsec) {
+    return ToMicroSeconds(hardware);
+  }
+  return ToMicroSeconds(&timestamps->ts[0]);
+}
+
+void IoTimestampingInitialize(void) {
+  for(size_t i = 0; i < OPENER_IO_TIMESTAMPING_MAX_SOCKETS; i++) {
+    s_sockets[i].socket = kEipInvalidSocket;
+    s_sockets[i].next_key = 0;
+    s_sockets[i].sent_messages = 0;
+  }
+  memset( s_sent_messages, 0, sizeof(s_sent_messages) );
+  s_next_sent_message = 0;
+}
+
+EipStatus IoTimestampingEnable(const int socket) {
+  IoTimestampingDisable(socket); /* the handle of a closed socket is reused */
+  IoTimestampingSocket *const entry = FindSocket(kEipInvalidSocket);
+  if(NULL == entry) {
+    OPENER_TRACE_WARN(
+      "io timestamping: no timestamps on socket %d, too many sockets\n",
+      socket);
+    return kEipStatusError;
+  }
+
+  int flags = kIoTimestampingFlags;
+  if(0 > setsockopt(socket, SOL_SOCKET, SO_TIMESTAMPING, &flags,
+                    sizeof(flags) ) ) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR(
+      "io timestamping: could not enable timestamps on socket %d: %d - %s\n",
+      socket,
+      error_code,
+      error_message);
+    FreeErrorMessage(error_message);
+    return kEipStatusError;
+  }
+  /* setting SOF_TIMESTAMPING_OPT_ID starts the numbering at 0 */
+  entry->socket = socket;
+  entry->next_key = 0;
+  entry->sent_messages = 0;
+  return kEipStatusOk;
+}
+
+void IoTimestampingDisable(const int socket) {
+  IoTimestampingSocket *const entry = FindSocket(socket);
+  if(NULL == entry || kEipInvalidSocket == socket) {
+    return;
+  }
+  for(size_t i = 0; i < OPENER_IO_TIMESTAMPING_MAX_SENT_MESSAGES; i++) {
+    if(entry == s_sent_messages[i].socket) {
+      RemoveSentMessage(&s_sent_messages[i]);
+    }
+  }
+  entry->socket = kEipInvalidSocket;
+}
+
+void IoTimestampingNoteSent(const int socket,
+                            const CipUdint connection_id,
+                            const MicroSeconds production_deadline) {
+  IoTimestampingSocket *const entry = FindSocket(socket);
+  if(NULL == entry || kEipInvalidSocket == socket) {
+    return;
+  }
+  IoTimestampingSentMessage *const sent_message =
+    &s_sent_messages[s_next_sent_message];
+  RemoveSentMessage(sent_message); /* its timestamp has not come in time */
+  sent_message->socket = entry;
+  sent_message->key = entry->next_key++;
+  sent_message->connection_id = connection_id;
+  sent_message->production_deadline = production_deadline;
+  entry->sent_messages++;
+  s_next_sent_message =
+    (s_next_sent_message + 1) % OPENER_IO_TIMESTAMPING_MAX_SENT_MESSAGES;
+}
+
+/** @brief Takes the next transmit timestamp from the error queue of a socket
+ *
+ * @param socket The socket
+ * @param key Returns the number of the datagram
+ * @param transmit_time Returns the time the datagram left
+ * @return false if the error queue is empty
+ */
+static bool ReceiveTransmitTimestamp(const int socket,
+                                     CipUdint *const key,
+                                     MicroSeconds *const transmit_time) {
+  char control[IO_TIMESTAMPING_CONTROL_SIZE +
+               CMSG_SPACE(sizeof(struct sock_extended_err) +
+                          sizeof(struct sockaddr_in) )];
+  struct msghdr message;
+  while(true) {
+    memset( &message, 0, sizeof(message) );
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    if(0 > recvmsg(socket, &message, MSG_ERRQUEUE | MSG_DONTWAIT) ) {
+      return false;
+    }
+
+    const struct scm_timestamping *timestamps = NULL;
+    const struct sock_extended_err *error = NULL;
+    for(struct cmsghdr *header = CMSG_FIRSTHDR(&message); NULL != header;
+        header = CMSG_NXTHDR(&message, header) ) {
+      if(SOL_SOCKET == header->cmsg_level &&
+         SCM_TIMESTAMPING == header->cmsg_type) {
+        timestamps = (const struct scm_timestamping *) CMSG_DATA(header);
+      } else if(IPPROTO_IP == header->cmsg_level &&
+                IP_RECVERR == header->cmsg_type) {
+        error = (const struct sock_extended_err *) CMSG_DATA(header);
+      }
+    }
+    if(NULL != timestamps && NULL != error &&
+       SO_EE_ORIGIN_TIMESTAMPING == error->ee_origin &&
+       SCM_TSTAMP_SND == error->ee_info) {
+      *key = error->ee_data;
+      *transmit_time = GetTimestamp(timestamps);
+      return true;
+    }
+  }
+}
+
+bool IoTimestampingReceiveTransmitted(CipUdint *const connection_id,
+                                      MicroSeconds *const production_deadline,
+                                      MicroSeconds *const transmit_time) {
+  for(size_t i = 0; i < OPENER_IO_TIMESTAMPING_MAX_SOCKETS; i++) {
+    IoTimestampingSocket *const entry = &s_sockets[i];
+    CipUdint key = 0;
+    while(0 < entry->sent_messages &&
+          ReceiveTransmitTimestamp(entry->socket, &key, transmit_time) ) {
+      /* the oldest sent messages are the most likely ones */
+      for(size_t j = 0; j < OPENER_IO_TIMESTAMPING_MAX_SENT_MESSAGES; j++) {
+        IoTimestampingSentMessage *const sent_message =
+          &s_sent_messages[(s_next_sent_message + j) %
+                           OPENER_IO_TIMESTAMPING_MAX_SENT_MESSAGES];
+        if(entry == sent_message->socket && key == sent_message->key) {
+          *connection_id = sent_message->connection_id;
+          *production_deadline = sent_message->production_deadline;
+          RemoveSentMessage(sent_message);
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+MicroSeconds IoTimestampingGetReceiveTime(const struct msghdr *const message) {
+  for(struct cmsghdr *header = CMSG_FIRSTHDR(message); NULL != header;
+      header = CMSG_NXTHDR( (struct msghdr *) message, header ) ) {
+    if(SOL_SOCKET == header->cmsg_level &&
+       SCM_TIMESTAMPING == header->cmsg_type) {
+      return GetTimestamp( (const struct scm_timestamping *) CMSG_DATA(header) );
+    }
+  }
+  return 0;
+}
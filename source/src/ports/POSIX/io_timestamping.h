@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#ifndef SRC_PORTS_POSIX_IO_TIMESTAMPING_H_
+#define SRC_PORTS_POSIX_IO_TIMESTAMPING_H_
+
+/** @file io_timestamping.h
+ *  @brief Transmit and receive timestamps of the implicit I/O sockets
+ *
+ *  The sockets are set up with SO_TIMESTAMPING. The kernel reports the time
+ *  a sent datagram left, numbered per socket, in the error queue of the
+ *  socket; these numbers are matched with the sent messages noted before.
+ *  Hardware timestamps are used if the network interface has been set up to
+ *  generate them, its clock is then expected to be synchronized to the system
+ *  clock, e.g. by phc2sys. Software timestamps are used otherwise.
+ */
+
+#include <stdbool.h>
+#include <sys/socket.h>
+#include <linux/errqueue.h>
+
+#include "typedefs.h"
+
+/** @brief Maximum number of sockets with timestamps */
+#ifndef OPENER_IO_TIMESTAMPING_MAX_SOCKETS
+  #define OPENER_IO_TIMESTAMPING_MAX_SOCKETS 64
+#endif
+
+/** @brief Number of sent messages waiting for their transmit timestamp,
+ *  the oldest ones are dropped first */
+#ifndef OPENER_IO_TIMESTAMPING_MAX_SENT_MESSAGES
+  #define OPENER_IO_TIMESTAMPING_MAX_SENT_MESSAGES 256
+#endif
+
+/** @brief Size of the control buffer receiving the timestamp of a datagram */
+#define IO_TIMESTAMPING_CONTROL_SIZE CMSG_SPACE(sizeof(struct scm_timestamping) )
+
+/** @brief
+ * Forgets all sockets and sent messages
+ */
+void IoTimestampingInitialize(void);
+
+/** @brief
+ * Enables transmit and receive timestamps on a UDP socket
+ *
+ * @param socket The UDP socket sending or receiving implicit I/O datagrams
+ * @return kEipStatusOk on success, kEipStatusError otherwise
+ */
+EipStatus IoTimestampingEnable(const int socket);
+
+/** @brief
+ * Forgets a socket and its sent messages, nothing happens for sockets
+ * without timestamps
+ *
+ * @param socket The socket to be closed
+ */
+void IoTimestampingDisable(const int socket);
+
+/** @brief
+ * Notes a datagram handed to the kernel, in the order of sending
+ *
+ * @param socket The socket the datagram was sent on
+ * @param connection_id The produced connection ID of the datagram
+ * @param production_deadline Time the datagram was due
+ */
+void IoTimestampingNoteSent(const int socket,
+                            const CipUdint connection_id,
+                            const MicroSeconds production_deadline);
+
+/** @brief
+ * Takes the next transmit timestamp of a noted datagram from the error
+ * queues of the sockets
+ *
+ * @param connection_id Returns the produced connection ID of the datagram
+ * @param production_deadline Returns the time the datagram was due
+ * @param transmit_time Returns the time the datagram left
+ * @return false if no more transmit timestamps are queued
+ */
+bool IoTimestampingReceiveTransmitted(CipUdint *const connection_id,
+                                      MicroSeconds *const production_deadline,
+                                      MicroSeconds *const transmit_time);
+
+/** @brief
+ * Gets the receive timestamp of a datagram received with a control buffer of
+ * IO_TIMESTAMPING_CONTROL_SIZE bytes
+ *
+ * @param message The received message
+ * @return The time the datagram was received on the time base of
+ *  GetMicroSeconds(), 0 if the message has no timestamp
+ */
+MicroSeconds IoTimestampingGetReceiveTime(const struct msghdr *const message);
+
+#endif /* SRC_PORTS_POSIX_IO_TIMESTAMPING_H_ */
@@ -5,14 +5,15 @@
  ******************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <inttypes.h>
 #include <signal.h>
 #include <time.h>
 #include <unistd.h>
+#include <sched.h>
 
-#ifdef OPENER_RT
+#if defined(OPENER_RT) || defined(OPENER_IO_THREAD)
 #include <pthread.h>
 #include <sys/mman.h>
-#include <sched.h>
 #include <limits.h>
 #endif
 
@@ -51,6 +52,55 @@ static void LeaveStack(int signal);
  */
 static void *executeEventLoop(void *pthread_arg);
 
+/******************************************************************************/
+/** @brief Parse the low latency options of the command line
+ *
+ * @param argc  number of command line parameters
+ * @param arg   the command line parameters
+ * @returns     index of the interface name in arg, 0 on invalid options
+ */
+static int parseOptions(int argc,
+                        char *arg[]);
+
+/******************************************************************************/
+/** @brief Print the wake up latency measured in the low latency mode
+ */
+static void reportWakeUpLatency(void);
+
+/******************************************************************************/
+/** @brief Print the number of messages produced per cycle of the connection
+ * timers
+ */
+static void reportProductionStatistics(void);
+
+/** @brief CPU the event loop is pinned to, -1 for no pinning */
+static int s_event_loop_cpu = -1;
+
+/** @brief Low latency options have been given on the command line */
+static int s_low_latency_mode = 0;
+
+#ifdef OPENER_IO_THREAD
+/******************************************************************************/
+/** @brief Execute the loop of the I/O thread
+ *
+ * @param   pthread_arg dummy argument
+ * @returns             pointer to internal dummy return value
+ */
+static void *executeIoLoop(void *pthread_arg);
+
+/******************************************************************************/
+/** @brief Create the I/O thread with SCHED_FIFO priority OPENER_IO_THREAD_PRIORITY,
+ *  pinned to the CPU OPENER_IO_THREAD_CPU unless it is negative
+ *
+ * @param   thread  returns the created thread
+ * @returns         0 on success, otherwise an error number
+ */
+static int startIoThread(pthread_t *const thread);
+
+/** @brief Flag ending both loops if one of them failed */
+static volatile int s_end_threads = 0;
+#endif /* OPENER_IO_THREAD */
+
 /******************************************************************************/
 /** @brief Fuzz TCP packets handling flow with AFL.
  *
@@ -68,12 +118,21 @@ volatile int g_end_stack = 0;
 int main(int argc,
          char *arg[]) {
 
-  if(argc != 2) {
-    fprintf(stderr, "Wrong number of command line parameters!\n");
-    fprintf(stderr, "Usage: %s [interface name]\n", arg[0]);
+  const int interface_index = parseOptions(argc, arg);
+  if(0 == interface_index) {
+    fprintf(stderr, "Wrong command line parameters!\n");
+    fprintf(stderr,
+            "Usage: %s [-c cpu] [-b busy poll us] [-s] [interface name]\n",
+            arg[0]);
+    fprintf(stderr, "\t-c pin the event loop to the CPU\n");
+    fprintf(stderr,
+            "\t-b busy poll the I/O sockets for the given microseconds\n");
+    fprintf(stderr, "\t-s spin instead of sleeping while waiting for data\n");
     fprintf(stderr, "\te.g. ./OpENer eth1\n");
+    fprintf(stderr, "\te.g. ./OpENer -c 3 -b 50 -s eth1\n");
     exit(EXIT_FAILURE);
   }
+  char *const interface_name = arg[interface_index];
 
   DoublyLinkedListInitialize(&connection_list,
                              CipConnectionObjectListArrayAllocator,
@@ -81,8 +140,8 @@ int main(int argc,
   /* Fetch MAC address from the platform. This tests also if the interface
    *  is present. */
   uint8_t iface_mac[6];
-  if(kEipStatusError == IfaceGetMacAddress(arg[1], iface_mac) ) {
-    printf("Network interface %s not found.\n", arg[1]);
+  if(kEipStatusError == IfaceGetMacAddress(interface_name, iface_mac) ) {
+    printf("Network interface %s not found.\n", interface_name);
     exit(EXIT_FAILURE);
   }
 
@@ -125,7 +184,7 @@ int main(int argc,
   }
 
   /* Bring up network interface or start DHCP client ... */
-  eip_status = BringupNetwork(arg[1],
+  eip_status = BringupNetwork(interface_name,
                               g_tcpip.config_control,
                               &g_tcpip.interface_configuration,
                               &g_tcpip.hostname);
@@ -148,7 +207,7 @@ int main(int argc,
     OPENER_TRACE_INFO("DHCP network configuration started\n");
     /* DHCP should already have been started with BringupNetwork(). Wait
      * here for IP present (DHCP done) or abort through g_end_stack. */
-    eip_status = IfaceWaitForIp(arg[1], -1, &g_end_stack);
+    eip_status = IfaceWaitForIp(interface_name, -1, &g_end_stack);
     OPENER_TRACE_INFO(
       "DHCP wait for interface: eip_status %d, g_end_stack=%d\n",
       eip_status,
@@ -156,7 +215,7 @@ int main(int argc,
     if(kEipStatusOk == eip_status && 0 == g_end_stack) {
       /* Read IP configuration received via DHCP from interface and store in
        *  the TCP/IP object.*/
-      eip_status = IfaceGetConfiguration(arg[1],
+      eip_status = IfaceGetConfiguration(interface_name,
                                          &g_tcpip.interface_configuration);
       if(eip_status < 0) {
         OPENER_TRACE_WARN("Problems getting interface configuration\n");
@@ -166,6 +225,21 @@ int main(int argc,
 
   /* The network initialization of the EIP stack for the NetworkHandler. */
   if(!g_end_stack && kEipStatusOk == NetworkHandlerInitialize() ) {
+#ifdef OPENER_IO_THREAD
+#ifndef OPENER_RT
+    /* Memory lock all, locked by the RT setup below otherwise */
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {
+      OPENER_TRACE_ERR("mlockall failed: %m\n");
+      exit(-2);
+    }
+#endif
+    pthread_t io_thread;
+    int io_thread_ret = startIoThread(&io_thread);
+    if (io_thread_ret) {
+      OPENER_TRACE_ERR("create I/O thread failed: %d\n", io_thread_ret);
+      exit(-2);
+    }
+#endif /* OPENER_IO_THREAD */
 #ifdef OPENER_RT
     int ret;
 
@@ -228,6 +302,19 @@ int main(int argc,
 #else
     (void) executeEventLoop(NULL);
 #endif
+#ifdef OPENER_IO_THREAD
+    s_end_threads = 1;
+    if (pthread_join(io_thread, NULL) ) {
+      OPENER_TRACE_ERR("join I/O thread failed: %m\n");
+    }
+#ifndef OPENER_RT
+    munlockall();
+#endif
+#endif /* OPENER_IO_THREAD */
+    if(s_low_latency_mode) {
+      reportWakeUpLatency();
+      reportProductionStatistics();
+    }
     /* clean up network state */
     NetworkHandlerFinish();
   }
@@ -236,7 +323,7 @@ int main(int argc,
   ShutdownCipStack();
 
   /* Shut down the network interface now. */
-  (void) ShutdownNetwork(arg[1]);
+  (void) ShutdownNetwork(interface_name);
 
   if(0 != g_end_stack) {
     printf("OpENer aborted by signal %d.\n", g_end_stack);
@@ -252,21 +339,140 @@ static void LeaveStack(int signal) {
   } OPENER_TRACE_STATE("got signal %d\n", signal);
 }
 
+static int parseOptions(int argc,
+                        char *arg[]) {
+  int option;
+  char *end;
+  while(-1 != (option = getopt(argc, arg, "c:b:s") ) ) {
+    switch(option) {
+      case 'c':
+        s_event_loop_cpu = (int) strtol(optarg, &end, 10);
+        if('\0' != *end || 0 > s_event_loop_cpu ||
+           CPU_SETSIZE <= s_event_loop_cpu) {
+          return 0;
+        }
+        break;
+      case 'b': {
+        const long busy_poll_time = strtol(optarg, &end, 10);
+        if('\0' != *end || 0 >= busy_poll_time) {
+          return 0;
+        }
+        g_network_status.busy_poll_time = (MicroSeconds) busy_poll_time;
+        break;
+      }
+      case 's':
+        g_network_status.spin_wait = true;
+        break;
+      default:
+        return 0;
+    }
+    s_low_latency_mode = 1;
+  }
+  /* exactly one interface name has to follow the options */
+  return (optind == argc - 1) ? optind : 0;
+}
+
+static void reportWakeUpLatency(void) {
+  const CipUdint wake_ups = g_network_status.wake_up_count;
+  printf("Wake up latency: %" PRIu32 " wake ups, mean %llu us, max %llu us\n",
+         wake_ups,
+         0 == wake_ups ? 0 : g_network_status.wake_up_latency_sum / wake_ups,
+         g_network_status.wake_up_latency_max);
+}
+
+static void reportProductionStatistics(void) {
+  const ProductionStatistics *const statistics = GetProductionStatistics();
+  printf("Productions: %" PRIu32 " in %" PRIu32 " cycles, max %" PRIu32
+         " per cycle\n",
+         statistics->productions,
+         statistics->production_cycles,
+         statistics->max_productions_per_cycle);
+}
+
 static void *executeEventLoop(void *pthread_arg) {
   static int pthread_dummy_ret;
   (void) pthread_arg;
 
+  if(0 <= s_event_loop_cpu) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET( (size_t) s_event_loop_cpu, &cpus);
+    /* pins the calling thread only */
+    if(0 != sched_setaffinity(0, sizeof(cpus), &cpus) ) {
+      OPENER_TRACE_ERR("pinning the event loop to CPU %d failed: %m\n",
+                       s_event_loop_cpu);
+    }
+  }
+
   /* The event loop. Put other processing you need done continually in here */
+#ifdef OPENER_IO_THREAD
+  while(!g_end_stack && !s_end_threads) {
+#else
   while(!g_end_stack) {
+#endif
     if(kEipStatusOk != NetworkHandlerProcessCyclic() ) {
       OPENER_TRACE_ERR("Error in NetworkHandler loop! Exiting OpENer!\n");
       break;
     }
+#ifdef OPENER_IO_THREAD
+    /* NV data is written without holding the stack lock */
+    if(kEipStatusError == NvdataStorePending() ) {
+      OPENER_TRACE_WARN("Storing of some NV data failed.\n");
+    }
+#endif
   }
 
   return &pthread_dummy_ret;
 }
 
+#ifdef OPENER_IO_THREAD
+static void *executeIoLoop(void *pthread_arg) {
+  static int pthread_dummy_ret;
+  (void) pthread_arg;
+
+  /* Implicit I/O only, explicit messaging is handled by executeEventLoop() */
+  while(!g_end_stack && !s_end_threads) {
+    if(kEipStatusOk != NetworkHandlerProcessImplicit() ) {
+      OPENER_TRACE_ERR("Error in I/O thread loop! Exiting OpENer!\n");
+      s_end_threads = 1;
+    }
+  }
+
+  return &pthread_dummy_ret;
+}
+
+static int startIoThread(pthread_t *const thread) {
+  pthread_attr_t attr;
+  int ret = pthread_attr_init(&attr);
+  if (ret) {
+    return ret;
+  }
+
+  struct sched_param param = { .sched_priority = OPENER_IO_THREAD_PRIORITY };
+  ret = pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+  if (!ret) {
+    ret = pthread_attr_setschedparam(&attr, &param);
+  }
+  if (!ret) {
+    ret = pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+  }
+#if OPENER_IO_THREAD_CPU >= 0
+  if (!ret) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(OPENER_IO_THREAD_CPU, &cpus);
+    ret = pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+  }
+#endif
+  if (!ret) {
+    ret = pthread_create(thread, &attr, executeIoLoop, NULL);
+  }
+
+  pthread_attr_destroy(&attr);
+  return ret;
+}
+#endif /* OPENER_IO_THREAD */
+
 #ifdef FUZZING_AFL
 static void fuzzHandlePacketFlow(void) {
   int socket_fd = 0;   // Fake socket fd
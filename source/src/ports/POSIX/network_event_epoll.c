@@ -0,0 +1,178 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file POSIX/network_event_epoll.c
+ *  @brief epoll based readiness backend for the POSIX port
+ *
+ *  In contrast to the select() backend the cost of a wait does not depend on
+ *  the highest file descriptor and there is no FD_SETSIZE limit.
+ */
+#include <errno.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include "network_event.h"
+
+#include "opener_error.h"
+#include "trace.h"
+
+/** @brief The epoll instance all watched sockets are registered at */
+static int s_epoll_handle = -1;
+
+/** @brief Timer waking up epoll_wait() for timeouts with a sub-millisecond
+ * part, -1 if not available */
+static int s_timer_handle = -1;
+
+/** @brief Receive array for epoll_wait() */
+static struct epoll_event s_epoll_events[OPENER_NETWORK_EVENT_MAX_EVENTS];
+
+static uint32_t NetworkEventToEpollEvents(const unsigned int events) {
+  uint32_t epoll_events = 0;
+  if(events & kNetworkEventReadable) {
+    epoll_events |= EPOLLIN;
+  }
+  if(events & kNetworkEventWritable) {
+    epoll_events |= EPOLLOUT;
+  }
+  return epoll_events;
+}
+
+EipStatus NetworkEventInitialize(void) {
+  s_epoll_handle = epoll_create1(EPOLL_CLOEXEC);
+  if(-1 == s_epoll_handle) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR("networkhandler: error creating epoll instance: %d - %s\n",
+                     error_code,
+                     error_message);
+    FreeErrorMessage(error_message);
+    return kEipStatusError;
+  }
+
+  s_timer_handle = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  struct epoll_event epoll_event = {
+    .events = EPOLLIN,
+    .data.fd = s_timer_handle
+  };
+  if(-1 == s_timer_handle ||
+     0 != epoll_ctl(s_epoll_handle, EPOLL_CTL_ADD, s_timer_handle,
+                    &epoll_event) ) {
+    /* not fatal, timeouts are rounded up to whole milliseconds then */
+    OPENER_TRACE_WARN(
+      "networkhandler: no timerfd, waits are limited to milliseconds\n");
+    if(-1 != s_timer_handle) {
+      close(s_timer_handle);
+      s_timer_handle = -1;
+    }
+  }
+  return kEipStatusOk;
+}
+
+void NetworkEventFinish(void) {
+  if(-1 != s_timer_handle) {
+    close(s_timer_handle);
+    s_timer_handle = -1;
+  }
+  if(-1 != s_epoll_handle) {
+    close(s_epoll_handle);
+    s_epoll_handle = -1;
+  }
+}
+
+EipStatus NetworkEventAddSocket(const int socket,
+                                const unsigned int events) {
+  struct epoll_event epoll_event = {
+    .events = NetworkEventToEpollEvents(events),
+    .data.fd = socket
+  };
+  if(0 != epoll_ctl(s_epoll_handle, EPOLL_CTL_ADD, socket, &epoll_event) ) {
+    /* a socket handle may be handed out again while still registered */
+    if(EEXIST == errno &&
+       0 == epoll_ctl(s_epoll_handle, EPOLL_CTL_MOD, socket, &epoll_event) ) {
+      return kEipStatusOk;
+    }
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR("networkhandler: error adding socket %d to epoll: %d - %s\n",
+                     socket,
+                     error_code,
+                     error_message);
+    FreeErrorMessage(error_message);
+    return kEipStatusError;
+  }
+  return kEipStatusOk;
+}
+
+EipStatus NetworkEventModifySocket(const int socket,
+                                   const unsigned int events) {
+  struct epoll_event epoll_event = {
+    .events = NetworkEventToEpollEvents(events),
+    .data.fd = socket
+  };
+  if(0 != epoll_ctl(s_epoll_handle, EPOLL_CTL_MOD, socket, &epoll_event) ) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR(
+      "networkhandler: error modifying socket %d in epoll: %d - %s\n",
+      socket,
+      error_code,
+      error_message);
+    FreeErrorMessage(error_message);
+    return kEipStatusError;
+  }
+  return kEipStatusOk;
+}
+
+void NetworkEventRemoveSocket(const int socket) {
+  /* failing is ok here, e.g., the socket was never registered */
+  (void) epoll_ctl(s_epoll_handle, EPOLL_CTL_DEL, socket, NULL);
+}
+
+int NetworkEventWait(const MicroSeconds timeout,
+                     NetworkEvent *const events,
+                     const size_t max_events) {
+  /* round up, we shall not return before the timeout expired */
+  int timeout_milliseconds = (int) ( (timeout + 999ULL) / 1000ULL );
+  int max_epoll_events = (int) (max_events < OPENER_NETWORK_EVENT_MAX_EVENTS ?
+                                max_events : OPENER_NETWORK_EVENT_MAX_EVENTS);
+
+  if(0 != timeout % 1000ULL && -1 != s_timer_handle) {
+    /* epoll_wait() only knows milliseconds, the timer ends the wait at the
+     * exact time, the rounded up timeout remains as fallback */
+    struct itimerspec expiry = {
+      .it_value.tv_sec = (time_t) (timeout / 1000000ULL),
+      .it_value.tv_nsec = (long) ( (timeout % 1000000ULL) * 1000ULL )
+    };
+    (void) timerfd_settime(s_timer_handle, 0, &expiry, NULL);
+  }
+
+  int number_of_events = epoll_wait(s_epoll_handle,
+                                    s_epoll_events,
+                                    max_epoll_events,
+                                    timeout_milliseconds);
+
+  int number_of_socket_events = 0;
+  for(int i = 0; i < number_of_events; i++) {
+    if(s_timer_handle == s_epoll_events[i].data.fd) {
+      uint64_t expirations = 0;
+      (void) read(s_timer_handle, &expirations, sizeof(expirations) );
+      continue;
+    }
+    NetworkEvent *const event = &events[number_of_socket_events++];
+    event->socket = s_epoll_events[i].data.fd;
+    event->events = kNetworkEventNone;
+    /* errors and hang ups are reported as readable, the following recv()
+     * reports the actual cause to the handler */
+    if(s_epoll_events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP) ) {
+      event->events |= kNetworkEventReadable;
+    }
+    if(s_epoll_events[i].events & EPOLLOUT) {
+      event->events |= kNetworkEventWritable;
+    }
+  }
+  return number_of_events < 0 ? number_of_events : number_of_socket_events;
+}
@@ -0,0 +1,388 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file POSIX/network_event_uring.c
+ *  @brief io_uring based readiness backend for the POSIX port
+ *
+ *  Every watched socket has a one-shot poll request queued in the ring. The
+ *  polls of the sockets reported by the last wait are armed again and
+ *  submitted together with the next wait, so a cycle of the network handler
+ *  needs a single io_uring_enter() call. One-shot polls complete immediately
+ *  on a socket which is still ready, which keeps the level-triggered
+ *  behavior of the other backends.
+ *
+ *  The ring is set up by raw system calls, liburing is not needed. Linux 5.13
+ *  or newer is required.
+ */
+#include <errno.h>
+#include <poll.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "network_event.h"
+
+#include "opener_error.h"
+#include "trace.h"
+
+/** @brief Maximum number of sockets watched at the same time */
+#ifndef OPENER_NETWORK_EVENT_URING_MAX_SOCKETS
+  #define OPENER_NETWORK_EVENT_URING_MAX_SOCKETS 128
+#endif
+
+/** @brief Number of submission queue entries, every socket needs at most a
+ *  poll and a poll removal */
+#define URING_QUEUE_ENTRIES (2 * OPENER_NETWORK_EVENT_URING_MAX_SOCKETS)
+
+/** @brief user_data of requests whose completion is not of interest */
+#define URING_IGNORED_COMPLETION UINT64_MAX
+
+/** @brief A watched socket */
+typedef struct {
+  int socket; /**< the socket, kEipInvalidSocket if the entry is unused */
+  unsigned int events; /**< watched events, see NetworkEventType */
+  uint32_t generation; /**< identifies the completions of the current poll */
+  bool armed; /**< a poll request is queued in the ring */
+} UringRegistration;
+
+/** @brief The io_uring instance and its mapped rings */
+typedef struct {
+  int handle; /**< io_uring file descriptor, -1 if not set up */
+  void *rings; /**< mapping of the submission and completion rings */
+  size_t rings_size; /**< size of the rings mapping */
+  struct io_uring_sqe *sqes; /**< submission queue entries */
+  size_t sqes_size; /**< size of the submission queue entries mapping */
+  unsigned int *sq_head;
+  unsigned int *sq_tail;
+  unsigned int *sq_mask;
+  unsigned int *sq_array;
+  unsigned int *cq_head;
+  unsigned int *cq_tail;
+  unsigned int *cq_mask;
+  struct io_uring_cqe *cqes;
+  unsigned int pending_submissions; /**< queued entries not submitted yet */
+} Uring;
+
+static Uring s_uring = { .handle = -1 };
+
+/** @brief The watched sockets, indexed by the user_data of their polls */
+static UringRegistration s_registrations[
+  OPENER_NETWORK_EVENT_URING_MAX_SOCKETS];
+
+static int UringSetup(const unsigned int entries,
+                      struct io_uring_params *const params) {
+  return (int) syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int UringEnter(const unsigned int to_submit,
+                      const unsigned int min_complete,
+                      const unsigned int flags,
+                      const void *const argument,
+                      const size_t argument_size) {
+  return (int) syscall(__NR_io_uring_enter, s_uring.handle, to_submit,
+                       min_complete, flags, argument, argument_size);
+}
+
+static void TraceUringError(const char *const action) {
+  int error_code = GetSocketErrorNumber();
+  char *error_message = GetErrorMessage(error_code);
+  OPENER_TRACE_ERR("networkhandler: error %s io_uring: %d - %s\n",
+                   action,
+                   error_code,
+                   error_message);
+  FreeErrorMessage(error_message);
+}
+
+/** @brief Submits the queued requests without waiting for completions
+ *
+ *  @return kEipStatusOk on success, otherwise kEipStatusError
+ */
+static EipStatus UringSubmit(void) {
+  while(0 < s_uring.pending_submissions) {
+    int submitted = UringEnter(s_uring.pending_submissions, 0, 0, NULL, 0);
+    if(0 > submitted) {
+      if(EINTR == errno) {
+        continue;
+      }
+      TraceUringError("submitting to");
+      return kEipStatusError;
+    }
+    s_uring.pending_submissions -= (unsigned int) submitted;
+  }
+  return kEipStatusOk;
+}
+
+/** @brief Gets a free submission queue entry, submits the queued requests if
+ *  the submission queue is full
+ *
+ *  @return the cleared entry, NULL on error
+ */
+static struct io_uring_sqe *UringGetSqe(void) {
+  const unsigned int head = __atomic_load_n(s_uring.sq_head, __ATOMIC_ACQUIRE);
+  const unsigned int tail = *s_uring.sq_tail;
+  if(tail - head > *s_uring.sq_mask) {
+    if(kEipStatusOk != UringSubmit() ) {
+      return NULL;
+    }
+  }
+  const unsigned int index = tail & *s_uring.sq_mask;
+  struct io_uring_sqe *const sqe = &s_uring.sqes[index];
+  memset(sqe, 0, sizeof(*sqe) );
+  s_uring.sq_array[index] = index;
+  __atomic_store_n(s_uring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+  s_uring.pending_submissions++;
+  return sqe;
+}
+
+static uint64_t UringRegistrationUserData(
+  const UringRegistration *const registration) {
+  return ( (uint64_t) registration->generation << 32 ) |
+         (uint64_t) (registration - s_registrations);
+}
+
+static EipStatus UringArmPoll(UringRegistration *const registration) {
+  struct io_uring_sqe *const sqe = UringGetSqe();
+  if(NULL == sqe) {
+    return kEipStatusError;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = registration->socket;
+  sqe->poll32_events = 0;
+  if(registration->events & kNetworkEventReadable) {
+    sqe->poll32_events |= POLLIN;
+  }
+  if(registration->events & kNetworkEventWritable) {
+    sqe->poll32_events |= POLLOUT;
+  }
+  sqe->user_data = UringRegistrationUserData(registration);
+  registration->armed = true;
+  return kEipStatusOk;
+}
+
+/** @brief Cancels the queued poll of a registration, completions of the
+ *  cancelled poll are recognized by the changed generation */
+static EipStatus UringDisarmPoll(UringRegistration *const registration) {
+  if(registration->armed) {
+    struct io_uring_sqe *const sqe = UringGetSqe();
+    if(NULL == sqe) {
+      return kEipStatusError;
+    }
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = UringRegistrationUserData(registration);
+    sqe->user_data = URING_IGNORED_COMPLETION;
+    registration->armed = false;
+  }
+  registration->generation++;
+  return kEipStatusOk;
+}
+
+static UringRegistration *UringGetRegistration(const int socket) {
+  for(size_t i = 0; i < OPENER_NETWORK_EVENT_URING_MAX_SOCKETS; i++) {
+    if(socket == s_registrations[i].socket) {
+      return &s_registrations[i];
+    }
+  }
+  return NULL;
+}
+
+EipStatus NetworkEventInitialize(void) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params) );
+  s_uring.handle = UringSetup(URING_QUEUE_ENTRIES, &params);
+  if(-1 == s_uring.handle) {
+    TraceUringError("creating");
+    return kEipStatusError;
+  }
+  if( !(params.features & IORING_FEAT_SINGLE_MMAP) ||
+      !(params.features & IORING_FEAT_EXT_ARG) ) {
+    OPENER_TRACE_ERR("networkhandler: io_uring of the kernel is too old\n");
+    NetworkEventFinish();
+    return kEipStatusError;
+  }
+
+  const size_t sq_size = params.sq_off.array +
+                         params.sq_entries * sizeof(unsigned int);
+  const size_t cq_size = params.cq_off.cqes +
+                         params.cq_entries * sizeof(struct io_uring_cqe);
+  s_uring.rings_size = sq_size > cq_size ? sq_size : cq_size;
+  s_uring.rings = mmap(NULL, s_uring.rings_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, s_uring.handle,
+                       IORING_OFF_SQ_RING);
+  s_uring.sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  s_uring.sqes = mmap(NULL, s_uring.sqes_size, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, s_uring.handle,
+                      IORING_OFF_SQES);
+  if(MAP_FAILED == s_uring.rings || MAP_FAILED == s_uring.sqes) {
+    TraceUringError("mapping");
+    NetworkEventFinish();
+    return kEipStatusError;
+  }
+
+  char *const rings = s_uring.rings;
+  s_uring.sq_head = (unsigned int *) (rings + params.sq_off.head);
+  s_uring.sq_tail = (unsigned int *) (rings + params.sq_off.tail);
+  s_uring.sq_mask = (unsigned int *) (rings + params.sq_off.ring_mask);
+  s_uring.sq_array = (unsigned int *) (rings + params.sq_off.array);
+  s_uring.cq_head = (unsigned int *) (rings + params.cq_off.head);
+  s_uring.cq_tail = (unsigned int *) (rings + params.cq_off.tail);
+  s_uring.cq_mask = (unsigned int *) (rings + params.cq_off.ring_mask);
+  s_uring.cqes = (struct io_uring_cqe *) (rings + params.cq_off.cqes);
+  s_uring.pending_submissions = 0;
+
+  for(size_t i = 0; i < OPENER_NETWORK_EVENT_URING_MAX_SOCKETS; i++) {
+    s_registrations[i].socket = kEipInvalidSocket;
+    s_registrations[i].events = kNetworkEventNone;
+    s_registrations[i].generation = 0;
+    s_registrations[i].armed = false;
+  }
+  return kEipStatusOk;
+}
+
+void NetworkEventFinish(void) {
+  if(NULL != s_uring.sqes && MAP_FAILED != s_uring.sqes) {
+    munmap(s_uring.sqes, s_uring.sqes_size);
+  }
+  if(NULL != s_uring.rings && MAP_FAILED != s_uring.rings) {
+    munmap(s_uring.rings, s_uring.rings_size);
+  }
+  s_uring.sqes = NULL;
+  s_uring.rings = NULL;
+  if(-1 != s_uring.handle) {
+    close(s_uring.handle);
+    s_uring.handle = -1;
+  }
+}
+
+EipStatus NetworkEventAddSocket(const int socket,
+                                const unsigned int events) {
+  /* a socket handle may be handed out again while still registered */
+  UringRegistration *registration = UringGetRegistration(socket);
+  if(NULL == registration) {
+    registration = UringGetRegistration(kEipInvalidSocket);
+    if(NULL == registration) {
+      OPENER_TRACE_ERR(
+        "networkhandler: no io_uring registration left for socket %d\n",
+        socket);
+      return kEipStatusError;
+    }
+    registration->socket = socket;
+  } else if(kEipStatusOk != UringDisarmPoll(registration) ) {
+    return kEipStatusError;
+  }
+  registration->events = events;
+  /* armed by the next wait */
+  return kEipStatusOk;
+}
+
+EipStatus NetworkEventModifySocket(const int socket,
+                                   const unsigned int events) {
+  UringRegistration *const registration = UringGetRegistration(socket);
+  if(NULL == registration) {
+    OPENER_TRACE_ERR("networkhandler: socket %d is not watched\n", socket);
+    return kEipStatusError;
+  }
+  if(events == registration->events) {
+    return kEipStatusOk;
+  }
+  if(kEipStatusOk != UringDisarmPoll(registration) ) {
+    return kEipStatusError;
+  }
+  registration->events = events;
+  /* armed by the next wait */
+  return kEipStatusOk;
+}
+
+void NetworkEventRemoveSocket(const int socket) {
+  UringRegistration *const registration = UringGetRegistration(socket);
+  if(NULL == registration) {
+    return; /* e.g., the socket was never registered */
+  }
+  const bool was_armed = registration->armed;
+  (void) UringDisarmPoll(registration);
+  registration->socket = kEipInvalidSocket;
+  registration->events = kNetworkEventNone;
+  if(was_armed) {
+    /* the poll keeps the socket open until it is removed */
+    (void) UringSubmit();
+  }
+}
+
+int NetworkEventWait(const MicroSeconds timeout,
+                     NetworkEvent *const events,
+                     const size_t max_events) {
+  for(size_t i = 0; i < OPENER_NETWORK_EVENT_URING_MAX_SOCKETS; i++) {
+    if(kEipInvalidSocket != s_registrations[i].socket &&
+       !s_registrations[i].armed) {
+      if(kEipStatusOk != UringArmPoll(&s_registrations[i]) ) {
+        return -1;
+      }
+    }
+  }
+
+  struct __kernel_timespec wait_time = {
+    .tv_sec = (long long) (timeout / 1000000ULL),
+    .tv_nsec = (long long) ( (timeout % 1000000ULL) * 1000ULL )
+  };
+  struct io_uring_getevents_arg wait_argument = {
+    .ts = (uint64_t) (uintptr_t) &wait_time
+  };
+  /* submit the armed polls and wait with one call */
+  int result = UringEnter(s_uring.pending_submissions,
+                          1,
+                          IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                          &wait_argument,
+                          sizeof(wait_argument) );
+  if(0 > result) {
+    if(ETIME != errno) {
+      return -1; /* nothing was submitted, e.g., EINTR */
+    }
+  } else {
+    s_uring.pending_submissions -= (unsigned int) result;
+  }
+
+  /* collect the completions, the ones which do not fit are kept for the next
+   * call */
+  size_t number_of_events = 0;
+  unsigned int head = *s_uring.cq_head;
+  const unsigned int tail = __atomic_load_n(s_uring.cq_tail, __ATOMIC_ACQUIRE);
+  while(head != tail && number_of_events < max_events) {
+    const struct io_uring_cqe *const cqe = &s_uring.cqes[head & *s_uring.cq_mask];
+    head++;
+    if(URING_IGNORED_COMPLETION == cqe->user_data) {
+      continue;
+    }
+    const size_t index = (size_t) (cqe->user_data & UINT32_MAX);
+    if(index >= OPENER_NETWORK_EVENT_URING_MAX_SOCKETS) {
+      continue;
+    }
+    UringRegistration *const registration = &s_registrations[index];
+    if( (uint32_t) (cqe->user_data >> 32) != registration->generation ||
+        !registration->armed ) {
+      continue; /* completion of a removed poll */
+    }
+    registration->armed = false;
+    if(-ECANCELED == cqe->res) {
+      continue;
+    }
+    events[number_of_events].socket = registration->socket;
+    events[number_of_events].events = kNetworkEventNone;
+    /* errors and hang ups are reported as readable, the following recv()
+     * reports the actual cause to the handler */
+    if(0 > cqe->res || (cqe->res & (POLLIN | POLLERR | POLLHUP) ) ) {
+      events[number_of_events].events |= kNetworkEventReadable;
+    }
+    if(0 <= cqe->res && (cqe->res & POLLOUT) ) {
+      events[number_of_events].events |= kNetworkEventWritable;
+    }
+    number_of_events++;
+  }
+  __atomic_store_n(s_uring.cq_head, head, __ATOMIC_RELEASE);
+  return (int) number_of_events;
+}
@@ -7,6 +7,7 @@
 #include <sys/time.h>
 #include <time.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -68,3 +69,26 @@ int SetQosOnSocket(const int socket,
   int set_tos = qos_value << 2;
   return setsockopt(socket, IPPROTO_IP, IP_TOS, &set_tos, sizeof(set_tos) );
 }
+
+int SetBusyPollOnSocket(const int socket,
+                        const MicroSeconds busy_poll_time) {
+#ifdef SO_BUSY_POLL
+  int busy_poll = busy_poll_time > INT_MAX ? INT_MAX : (int) busy_poll_time;
+  int result = setsockopt(socket, SOL_SOCKET, SO_BUSY_POLL, &busy_poll,
+                          sizeof(busy_poll) );
+#ifdef SO_PREFER_BUSY_POLL
+  /* keeps the interrupts of the device queue off while busy polling,
+   * the option is missing before Linux 5.11 */
+  if(0 == result) {
+    int prefer_busy_poll = 1;
+    (void) setsockopt(socket, SOL_SOCKET, SO_PREFER_BUSY_POLL,
+                      &prefer_busy_poll, sizeof(prefer_busy_poll) );
+  }
+#endif
+  return result;
+#else
+  (void) socket;
+  (void) busy_poll_time;
+  return 0;
+#endif
+}
@@ -139,8 +139,10 @@ EipStatus AfterAssemblyDataReceived(CipInstance *instance) {
   switch (instance->instance_number) {
     case DEMO_APP_OUTPUT_ASSEMBLY_NUM:
       /* Data for the output assembly has been received.
-       * Mirror it to the inputs */
-      memcpy( &g_assembly_data064[0], &g_assembly_data096[0],
+       * Mirror it to the inputs, the data is read via the instance as it
+       * may still be in the receive buffer */
+      memcpy( &g_assembly_data064[0],
+              ( (CipByteArray *) instance->attributes->data )->data,
               sizeof(g_assembly_data064) );
       break;
     case DEMO_APP_EXPLICT_ASSEMBLY_NUM:
@@ -11,6 +11,11 @@
 #include "encap.h"
 #include "opener_user_conf.h"
 
+MicroSeconds GetMicroSeconds(void) {
+  /* the kernel tick is the finest time base available */
+  return (MicroSeconds) osKernelSysTick() * 1000ULL;
+}
+
 MilliSeconds GetMilliSeconds(void) {
   return osKernelSysTick();
 }
@@ -50,3 +55,12 @@ int SetQosOnSocket(const int socket,
   int set_tos = qos_value << 2;
   return setsockopt(socket, IPPROTO_IP, IP_TOS, &set_tos, sizeof(set_tos));
 }
+
+int SetBusyPollOnSocket(const int socket,
+                        const MicroSeconds busy_poll_time) {
+  /* Suppress unused parameter compiler warning. */
+  (void) socket;
+  (void) busy_poll_time;
+
+  return 0; // Busy polling is not supported on this platform
+}
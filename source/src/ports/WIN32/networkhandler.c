@@ -61,3 +61,12 @@ int SetQosOnSocket(const int socket,
 
   return 0; // Dummy implementation, until a working one is viable
 }
+
+int SetBusyPollOnSocket(const int socket,
+                        const MicroSeconds busy_poll_time) {
+  /* Suppress unused parameter compiler warning. */
+  (void) socket;
+  (void) busy_poll_time;
+
+  return 0; // Busy polling is not supported on this platform
+}
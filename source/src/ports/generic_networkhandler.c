@@ -15,6 +15,15 @@
 #include <inttypes.h>
 #include <stdbool.h>
 #include <signal.h>
+#if defined(OPENER_HAVE_RECVMMSG) || defined(OPENER_HAVE_SENDMMSG)
+#include <sys/uio.h>
+#endif
+#ifdef OPENER_IO_THREAD
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
 
 #include "generic_networkhandler.h"
 
@@ -25,8 +34,34 @@
 #include "ciptcpipinterface.h"
 #include "opener_user_conf.h"
 #include "cipqos.h"
+#if defined(OPENER_IO_SOCKET_FILTER)
+#include "io_socket_filter.h"
+#endif
+#if defined(OPENER_IO_TIMESTAMPING)
+#include "io_timestamping.h"
+#include "hashindex.h"
+#endif
+
+/** @brief Backlog of the TCP listener, big enough for all peers reconnecting
+ * at the same time, e.g., after a switch reboot. Connections beyond
+ * OPENER_TCP_CONNECTION_LIMIT are closed right after being accepted. */
+#ifdef SOMAXCONN
+  #define MAX_NO_OF_TCP_SOCKETS SOMAXCONN
+#else
+  #define MAX_NO_OF_TCP_SOCKETS OPENER_TCP_CONNECTION_LIMIT
+#endif
+
+/** @brief Maximum number of I/O datagrams received with one system call */
+#ifndef OPENER_UDP_RECEIVE_BATCH_SIZE
+#define OPENER_UDP_RECEIVE_BATCH_SIZE 16
+#endif
 
-#define MAX_NO_OF_TCP_SOCKETS 10
+/** @brief Maximum number of batches received from a consuming socket per
+ *  wakeup, a socket still readable afterwards is handled again in the next
+ *  cycle */
+#ifndef OPENER_UDP_RECEIVE_BATCHES_PER_WAKEUP
+#define OPENER_UDP_RECEIVE_BATCHES_PER_WAKEUP 4
+#endif
 
 /** @brief Ethernet/IP standard port */
 
@@ -61,15 +96,73 @@
 
 SocketTimer g_timestamps[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
 
+/** @brief Storage of the socket timer index, twice as many slots as socket
+ * timers keep the probe sequences short
+ */
+static SocketTimer *s_socket_timer_index_storage[
+  2 * OPENER_NUMBER_OF_SUPPORTED_SESSIONS + 1];
+
+/** @brief The socket timers in use indexed by their socket */
+static SocketTimerIndex s_socket_timer_index;
+
+/** @brief Storage of the inactivity timer queue */
+static DeadlineQueueEntry *s_inactivity_timer_storage[
+  OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+
+/** @brief The next encapsulation inactivity checks of the sessions ordered by
+ * their expiry
+ */
+static DeadlineQueue s_inactivity_timers;
+
+/** @brief Encapsulation inactivity timeout in seconds the queued inactivity
+ * timers are based on, 0 if disabled
+ */
+static CipUint s_inactivity_timeout = 0;
+
+/** @brief Receive buffers of the accepted TCP sockets */
+TcpReceiveBuffer g_tcp_receive_buffers[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+
+/** @brief Storage of the receive buffer index, twice as many slots as
+ * receive buffers keep the probe sequences short
+ */
+static HashIndexEntry s_tcp_receive_buffer_index_storage[
+  2 * OPENER_NUMBER_OF_SUPPORTED_SESSIONS + 1];
+
+/** @brief The receive buffers in use indexed by their socket, looked up for
+ * every received TCP segment
+ */
+static HashIndex s_tcp_receive_buffer_index;
+
+/** @brief Send queues of the accepted TCP sockets */
+TcpSendQueue g_tcp_send_queues[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+
+/** @brief Storage of the send queue index, twice as many slots as send
+ * queues keep the probe sequences short
+ */
+static HashIndexEntry s_tcp_send_queue_index_storage[
+  2 * OPENER_NUMBER_OF_SUPPORTED_SESSIONS + 1];
+
+/** @brief The send queues in use indexed by their socket, looked up for
+ * every reply and writable event
+ */
+static HashIndex s_tcp_send_queue_index;
+
+/** @brief Receive buffer of the UDP unicast and broadcast listeners, the
+ * requests are parsed in place and answered before the next receive
+ */
+static CipOctet s_udp_receive_buffer[PC_OPENER_ETHERNET_BUFFER_SIZE];
+
+#if defined(OPENER_IO_SOCKET_FILTER)
+/** @brief Kernel filter of the consuming I/O sockets, rebuilt whenever the
+ * active connections change
+ */
+static IoSocketFilter s_io_socket_filter;
+#endif /* defined(OPENER_IO_SOCKET_FILTER) */
+
 //EipUint8 g_ethernet_communication_buffer[PC_OPENER_ETHERNET_BUFFER_SIZE]; /**< communication buffer */
 /* global vars */
-fd_set master_socket;
-fd_set read_socket;
-
-int highest_socket_handle;
 int g_current_active_tcp_socket;
 
-struct timeval g_time_value;
 MilliSeconds g_actual_time;
 MilliSeconds g_last_time;
 
@@ -83,6 +176,90 @@ NetworkStatus g_network_status;
  */
 TimeoutCheckerFunction timeout_checker_array[OPENER_TIMEOUT_CHECKER_ARRAY_SIZE];
 
+/** @brief Sockets reported ready by the network event backend in the current
+ * cycle, handled entries get their events cleared
+ */
+static NetworkEvent ready_events[OPENER_NETWORK_EVENT_MAX_EVENTS];
+
+/** @brief Number of valid entries in ready_events */
+static int ready_event_count = 0;
+
+/** @brief Time at which the explicit messaging of the current cycle has to
+ * stop, see OPENER_EXPLICIT_MESSAGING_TIME_BUDGET_US
+ */
+static MicroSeconds s_explicit_messaging_deadline = 0;
+
+/** @brief Sockets of the TCP sessions deferred by the time budget, they are
+ * served first in the next cycle in this order
+ */
+static int s_deferred_sessions[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+
+/** @brief Number of valid entries in s_deferred_sessions */
+static size_t s_number_of_deferred_sessions = 0;
+
+/** @brief Events reported for the TCP sessions listed in the current cycle,
+ * by their slot in g_tcp_receive_buffers
+ */
+static unsigned int s_tcp_session_events[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+
+/** @brief The TCP sessions listed in the current cycle, by their slot in
+ * g_tcp_receive_buffers
+ */
+static bool s_tcp_session_is_listed[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+
+/** @brief Requests have been left in the receive buffers when the time budget
+ * was used up, the next cycle must not wait for network events
+ */
+static bool s_explicit_messages_pending = false;
+
+/** @brief Time the loop handling the implicit I/O has to wake up for the next
+ * connection timer or tick, 0 if the wake up has already been measured
+ */
+static MicroSeconds s_planned_wake_up_time = 0;
+
+#ifdef OPENER_IO_THREAD
+/** @brief Serializes the access of the I/O thread and the explicit messaging
+ * thread to the stack
+ *
+ * Priority inheritance bounds the time the I/O thread waits for the explicit
+ * messaging thread to a single request.
+ */
+static pthread_mutex_t s_stack_lock;
+
+/** @brief Pipe waking up the I/O thread, e.g., for a new connection */
+static int s_io_thread_wake_pipe[2] = { -1, -1 };
+
+/** @brief Latest time the I/O thread wakes up, guarded by s_stack_lock */
+static MicroSeconds s_io_thread_wake_time = 0;
+
+/** @brief The consuming sockets changed since the I/O thread copied them to
+ * the sockets it watches, guarded by s_stack_lock */
+static bool s_io_thread_sockets_changed = false;
+
+/** @brief The sockets consumed from by the active connections, each one
+ * listed once, guarded by s_stack_lock */
+static int *s_consuming_sockets = NULL;
+
+/** @brief Number of entries of s_consuming_sockets */
+static size_t s_number_of_consuming_sockets = 0;
+
+/** @brief Sockets watched by the I/O thread, the first one is the wake pipe
+ * followed by the consuming sockets */
+static struct pollfd *s_io_thread_sockets = NULL;
+
+/** @brief Number of entries of s_io_thread_sockets, sized from the connection
+ * capacity when the network handler is initialized */
+static nfds_t s_io_thread_max_sockets = 0;
+
+/** @brief Number of entries of s_io_thread_sockets watched by the I/O thread,
+ * only used by the I/O thread */
+static nfds_t s_io_thread_watched_sockets = 0;
+
+/** @brief Number of ready entries in s_io_thread_sockets being handled, 0
+ * while the I/O thread waits, guarded by s_stack_lock */
+static nfds_t s_io_thread_socket_count = 0;
+#endif /* OPENER_IO_THREAD */
+
 /** @brief handle any connection request coming in the TCP server socket.
  *
  */
@@ -103,6 +280,31 @@ void CheckAndHandleUdpGlobalBroadcastSocket(void);
  */
 void CheckAndHandleConsumingUdpSocket(void);
 
+/** @brief Receives the data of a socket reported ready if it still is a
+ *  consuming socket
+ *
+ *  The socket may have been closed and its handle reused since it was
+ *  reported ready. A connection whose socket fails is looked up by the socket
+ *  and closed.
+ *
+ *  @param socket The ready socket
+ */
+static void HandleConsumingUdpSocket(const int socket);
+
+/** @brief Receives the datagrams pending on a consuming UDP socket and hands
+ *  them to the connection manager
+ *
+ *  Where available recvmmsg() is used to receive up to
+ *  OPENER_UDP_RECEIVE_BATCH_SIZE datagrams with one system call. At most
+ *  OPENER_UDP_RECEIVE_BATCHES_PER_WAKEUP batches are received, so a flooded
+ *  socket cannot starve the productions, the timers and explicit messaging.
+ *
+ *  @param socket The ready consuming socket
+ *  @return kEipStatusOk if no socket error occurred, kEipStatusError
+ *  otherwise
+ */
+EipStatus ReceiveConnectedDataOnUdpSocket(const int socket);
+
 /** @brief Handles data on an established TCP connection, processed connection is given by socket
  *
  *  @param socket The socket to be processed
@@ -110,9 +312,61 @@ void CheckAndHandleConsumingUdpSocket(void);
  */
 EipStatus HandleDataOnTcpSocket(int socket);
 
-void CheckEncapsulationInactivity(int socket_handle);
+/** @brief Handles one complete encapsulation message received on a TCP socket
+ *  and sends the reply
+ *
+ *  @param socket The socket the message was received on
+ *  @param message Start of the message
+ *  @param message_size Size of the message including the encapsulation header
+ *  @return kEipStatusError if the reply could not be sent or queued
+ */
+EipStatus HandleEncapsulationMessageOnTcpSocket(const int socket,
+                                                CipOctet *const message,
+                                                const size_t message_size);
+
+/** @brief Sends the queued reply bytes of a writable TCP socket and resumes
+ *  the handling of its requests once the send queue has room again
+ *
+ *  @param socket The writable socket
+ *  @return kEipStatusError if the socket failed
+ */
+EipStatus HandleWritableTcpSocket(const int socket);
+
+/** @brief Closes the sessions whose encapsulation inactivity timer expired
+ */
+void CheckEncapsulationInactivity(void);
+
+/** @brief Handles the explicit messages of the cycle within the time budget
+ */
+static void HandleExplicitMessaging(void);
+
+/** @brief Sets the configured busy poll time on an I/O socket
+ *
+ *  @param socket The UDP socket sending or receiving implicit I/O data
+ */
+static void SetBusyPollOnIoSocket(const int socket);
+
+/** @brief Notes when the loop handling the implicit I/O has to wake up
+ *
+ *  @param timeout Time until the next connection timer or tick
+ *  @return The time to wait for network events, 0 in spin wait mode
+ */
+static MicroSeconds PlanWakeUp(const MicroSeconds timeout);
+
+/** @brief Adds the delay of the wake up to the wake up latency statistics
+ *  once the planned wake up time has passed
+ */
+static void MeasureWakeUpLatency(void);
 
-void RemoveSocketTimerFromList(const int socket_handle);
+#if defined(OPENER_IO_TIMESTAMPING)
+/** @brief Passes the transmit timestamps of the produced messages to the
+ *  connection manager
+ *
+ *  The error queues holding them are drained on every cycle, also those of
+ *  sockets nobody consumes on, which would be reported ready otherwise.
+ */
+static void HandleTransmitTimestamps(void);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
 
 /*************************************************
 * Function implementations from now on
@@ -124,7 +378,36 @@ EipStatus NetworkHandlerInitialize(void) {
     return kEipStatusError;
   }
 
+  if( kEipStatusOk != NetworkEventInitialize() ) {
+    return kEipStatusError;
+  }
+#if defined(OPENER_IO_TIMESTAMPING)
+  IoTimestampingInitialize();
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+  ready_event_count = 0;
+  s_number_of_deferred_sessions = 0;
+
   SocketTimerArrayInitialize(g_timestamps, OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
+  SocketTimerIndexInitialize(&s_socket_timer_index,
+                             s_socket_timer_index_storage,
+                             sizeof(s_socket_timer_index_storage) /
+                             sizeof(s_socket_timer_index_storage[0]) );
+  DeadlineQueueInitialize(&s_inactivity_timers,
+                          s_inactivity_timer_storage,
+                          OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
+  s_inactivity_timeout = 0;
+  TcpReceiveBufferArrayInitialize(g_tcp_receive_buffers,
+                                  OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
+  HashIndexInitialize(&s_tcp_receive_buffer_index,
+                      s_tcp_receive_buffer_index_storage,
+                      sizeof(s_tcp_receive_buffer_index_storage) /
+                      sizeof(s_tcp_receive_buffer_index_storage[0]) );
+  TcpSendQueueArrayInitialize(g_tcp_send_queues,
+                              OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
+  HashIndexInitialize(&s_tcp_send_queue_index,
+                      s_tcp_send_queue_index_storage,
+                      sizeof(s_tcp_send_queue_index_storage) /
+                      sizeof(s_tcp_send_queue_index_storage[0]) );
   /* Activate the current DSCP values to become the used set of values. */
   CipQosUpdateUsedSetQosValues();
   /* Make sure the multicast configuration matches the current IP address. */
@@ -136,10 +419,6 @@ EipStatus NetworkHandlerInitialize(void) {
   /* Initialize encapsulation layer here because it accesses the IP address. */
   EncapsulationInit();
 
-  /* clear the master and temp sets */
-  FD_ZERO(&master_socket);
-  FD_ZERO(&read_socket);
-
   /* create a new TCP socket */
   if( ( g_network_status.tcp_listener =
           socket(AF_INET, SOCK_STREAM, IPPROTO_TCP) ) == -1 ) {
@@ -357,126 +636,501 @@ EipStatus NetworkHandlerInitialize(void) {
     return kEipStatusError;
   }
 
-  /* add the listener socket to the master set */
-  FD_SET(g_network_status.tcp_listener, &master_socket);
-  FD_SET(g_network_status.udp_unicast_listener, &master_socket);
-  FD_SET(g_network_status.udp_global_broadcast_listener, &master_socket);
-
-  /* keep track of the biggest file descriptor */
-  highest_socket_handle = GetMaxSocket(g_network_status.tcp_listener,
-                                       g_network_status.udp_global_broadcast_listener,
-                                       0,
-                                       g_network_status.udp_unicast_listener);
+  /* add the listener sockets to the watched sockets */
+  if( kEipStatusOk !=
+      NetworkEventAddSocket(g_network_status.tcp_listener,
+                            kNetworkEventReadable)
+      || kEipStatusOk !=
+      NetworkEventAddSocket(g_network_status.udp_unicast_listener,
+                            kNetworkEventReadable)
+      || kEipStatusOk !=
+      NetworkEventAddSocket(g_network_status.udp_global_broadcast_listener,
+                            kNetworkEventReadable) ) {
+    return kEipStatusError;
+  }
 
   g_last_time = GetMilliSeconds(); /* initialize time keeping */
   g_network_status.elapsed_time = 0;
+  g_network_status.tcp_connection_count = 0;
+  g_network_status.explicit_time_budget =
+    OPENER_EXPLICIT_MESSAGING_TIME_BUDGET_US;
+  s_explicit_messages_pending = false;
+  g_network_status.wake_up_count = 0;
+  g_network_status.wake_up_latency_sum = 0;
+  g_network_status.wake_up_latency_max = 0;
+  s_planned_wake_up_time = 0;
+
+#ifdef OPENER_IO_THREAD
+  pthread_mutexattr_t lock_attributes;
+  if(0 != pthread_mutexattr_init(&lock_attributes)
+     || 0 != pthread_mutexattr_setprotocol(&lock_attributes,
+                                           PTHREAD_PRIO_INHERIT)
+     || 0 != pthread_mutex_init(&s_stack_lock, &lock_attributes) ) {
+    OPENER_TRACE_ERR("networkhandler: error creating the stack lock\n");
+    return kEipStatusError;
+  }
+  pthread_mutexattr_destroy(&lock_attributes);
+
+  /* each I/O connection has at most one consuming socket */
+  const ConnectionCapacity *const capacity = GetConnectionCapacity();
+  s_io_thread_max_sockets = 1 + capacity->exclusive_owner_connection_points +
+                            capacity->input_only_connection_points *
+                            capacity->input_only_connections_per_point +
+                            capacity->listen_only_connection_points *
+                            capacity->listen_only_connections_per_point;
+  s_io_thread_sockets = CipCalloc(s_io_thread_max_sockets,
+                                  sizeof(struct pollfd) );
+  s_consuming_sockets = CipCalloc(s_io_thread_max_sockets, sizeof(int) );
+  if(NULL == s_io_thread_sockets || NULL == s_consuming_sockets) {
+    OPENER_TRACE_ERR(
+      "networkhandler: could not allocate the sockets of the I/O thread\n");
+    s_io_thread_max_sockets = 0;
+    return kEipStatusError;
+  }
+  s_number_of_consuming_sockets = 0;
+  s_io_thread_sockets_changed = false;
+
+  if(0 != pipe(s_io_thread_wake_pipe)
+     || -1 == fcntl(s_io_thread_wake_pipe[0], F_SETFL, O_NONBLOCK)
+     || -1 == fcntl(s_io_thread_wake_pipe[1], F_SETFL, O_NONBLOCK) ) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR(
+      "networkhandler: error creating the I/O thread wake pipe: %d - %s\n",
+      error_code,
+      error_message);
+    FreeErrorMessage(error_message);
+    return kEipStatusError;
+  }
+  s_io_thread_sockets[0].fd = s_io_thread_wake_pipe[0];
+  s_io_thread_sockets[0].events = POLLIN;
+  s_io_thread_watched_sockets = 1;
+#endif /* OPENER_IO_THREAD */
+
+  return kEipStatusOk;
+}
+
+#ifdef OPENER_IO_THREAD
+static void LockStack(void) {
+  (void) pthread_mutex_lock(&s_stack_lock);
+}
+
+static void UnlockStack(void) {
+  (void) pthread_mutex_unlock(&s_stack_lock);
+}
+
+/** @brief Wakes up the I/O thread if it has to watch a new socket or the next
+ * connection timer expires before its planned wake up
+ *
+ * Has to be called with the stack lock held.
+ */
+static void WakeIoThreadIfNeeded(void) {
+  const MicroSeconds current_time = GetMicroSeconds();
+  bool wake_up = s_io_thread_sockets_changed;
+  if(!wake_up && current_time < s_io_thread_wake_time) {
+    const MicroSeconds planned_wait = s_io_thread_wake_time - current_time;
+    wake_up = GetTimeToNextConnectionTimer(current_time, planned_wait) <
+              planned_wait;
+  }
+  if(wake_up) {
+    const char wake_up_byte = 0;
+    /* a full pipe already wakes up the thread */
+    (void) write(s_io_thread_wake_pipe[1], &wake_up_byte,
+                 sizeof(wake_up_byte) );
+  }
+}
+
+EipStatus NetworkHandlerProcessImplicit(void) {
+  /* copy the changed consuming sockets, the wait is done without the lock */
+  LockStack();
+#if defined(OPENER_IO_TIMESTAMPING)
+  HandleTransmitTimestamps();
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+  if(s_io_thread_sockets_changed) {
+    for(size_t i = 0; i < s_number_of_consuming_sockets; i++) {
+      s_io_thread_sockets[i + 1].fd = s_consuming_sockets[i];
+      s_io_thread_sockets[i + 1].events = POLLIN;
+    }
+    s_io_thread_watched_sockets = (nfds_t) s_number_of_consuming_sockets + 1;
+    s_io_thread_sockets_changed = false;
+  }
+  const nfds_t number_of_sockets = s_io_thread_watched_sockets;
+  /* wake up at least once per tick */
+  const MicroSeconds current_time = GetMicroSeconds();
+  const MicroSeconds time_to_next_timer = GetTimeToNextConnectionTimer(
+    current_time,
+    (MicroSeconds) kOpenerTimerTickInMilliSeconds * 1000ULL);
+  s_io_thread_wake_time = current_time + time_to_next_timer;
+  const MicroSeconds timeout = PlanWakeUp(time_to_next_timer);
+  UnlockStack();
+
+  const struct timespec wait_time = {
+    .tv_sec = (time_t) (timeout / 1000000ULL),
+    .tv_nsec = (long) ( (timeout % 1000000ULL) * 1000ULL )
+  };
+  int ready_sockets = ppoll(s_io_thread_sockets,
+                            number_of_sockets,
+                            &wait_time,
+                            NULL);
+  if(-1 == ready_sockets) {
+    if(EINTR == errno) {
+      return kEipStatusOk;
+    }
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR("networkhandler: error waiting in the I/O thread: %d - %s\n",
+                     error_code,
+                     error_message);
+    FreeErrorMessage(error_message);
+    return kEipStatusError;
+  }
+
+  MeasureWakeUpLatency();
+  LockStack();
+  if(s_io_thread_sockets[0].revents & POLLIN) {
+    char wake_up_bytes[16];
+    while(0 < read(s_io_thread_wake_pipe[0], wake_up_bytes,
+                   sizeof(wake_up_bytes) ) ) {
+    }
+  }
+  if(0 < ready_sockets) {
+    s_io_thread_socket_count = number_of_sockets;
+    /* only the consuming sockets are watched besides the wake pipe, a
+     * socket closed while handling an earlier one is not reported anymore */
+    for(nfds_t i = 1; i < s_io_thread_socket_count; i++) {
+      if(s_io_thread_sockets[i].revents & (POLLIN | POLLERR) ) {
+        s_io_thread_sockets[i].revents = 0;
+        HandleConsumingUdpSocket(s_io_thread_sockets[i].fd);
+      }
+    }
+    s_io_thread_socket_count = 0;
+  }
 
+  /* production and inactivity watchdogs of the connections */
+  ManageConnectionTimers(GetMicroSeconds() );
+  UnlockStack();
   return kEipStatusOk;
 }
+#endif /* OPENER_IO_THREAD */
+
+static void SetBusyPollOnIoSocket(const int socket) {
+  if(0 == g_network_status.busy_poll_time) {
+    return;
+  }
+  if(0 != SetBusyPollOnSocket(socket, g_network_status.busy_poll_time) ) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_WARN(
+      "networkhandler: error setting busy poll on socket %d: %d - %s\n",
+      socket,
+      error_code,
+      error_message);
+    FreeErrorMessage(error_message);
+    /* the socket works without busy polling */
+  }
+}
+
+static MicroSeconds PlanWakeUp(const MicroSeconds timeout) {
+  /* a timer already due keeps the wake up time planned before */
+  if(0 < timeout || 0 == s_planned_wake_up_time) {
+    s_planned_wake_up_time = GetMicroSeconds() + timeout;
+  }
+  return g_network_status.spin_wait ? 0 : timeout;
+}
+
+static void MeasureWakeUpLatency(void) {
+  if(0 == s_planned_wake_up_time) {
+    return;
+  }
+  const MicroSeconds current_time = GetMicroSeconds();
+  if(current_time < s_planned_wake_up_time) {
+    return; /* woken up by a network event */
+  }
+  const MicroSeconds latency = current_time - s_planned_wake_up_time;
+  g_network_status.wake_up_count++;
+  g_network_status.wake_up_latency_sum += latency;
+  if(latency > g_network_status.wake_up_latency_max) {
+    g_network_status.wake_up_latency_max = latency;
+  }
+  s_planned_wake_up_time = 0;
+}
+
+#if defined(OPENER_IO_TIMESTAMPING)
+static void HandleTransmitTimestamps(void) {
+  CipUdint connection_id = 0;
+  MicroSeconds production_deadline = 0;
+  MicroSeconds transmit_time = 0;
+  while( IoTimestampingReceiveTransmitted(&connection_id,
+                                          &production_deadline,
+                                          &transmit_time) ) {
+    HandleTransmittedConnectedData(connection_id,
+                                   production_deadline,
+                                   transmit_time);
+  }
+}
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
 
 void CloseUdpSocket(int socket_handle) {
   OPENER_TRACE_STATE("Closing UDP socket %d\n", socket_handle);
+#if defined(OPENER_IO_TIMESTAMPING)
+  IoTimestampingDisable(socket_handle);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
   CloseSocket(socket_handle);
 }
 
+/** @brief Gets the receive buffer of an accepted TCP socket
+ *
+ * @return The receive buffer, NULL if the socket has none
+ */
+static TcpReceiveBuffer *GetTcpReceiveBuffer(const int socket) {
+  return HashIndexFind(&s_tcp_receive_buffer_index, (uint32_t) socket, NULL,
+                       NULL);
+}
+
+/** @brief Gets the send queue of an accepted TCP socket
+ *
+ * @return The send queue, NULL if the socket has none
+ */
+static TcpSendQueue *GetTcpSendQueue(const int socket) {
+  return HashIndexFind(&s_tcp_send_queue_index, (uint32_t) socket, NULL,
+                       NULL);
+}
+
 void CloseTcpSocket(int socket_handle) {
   OPENER_TRACE_STATE("Closing TCP socket %d\n", socket_handle);
   ShutdownSocketPlatform(socket_handle);
   RemoveSocketTimerFromList(socket_handle);
+  TcpReceiveBuffer *receive_buffer = GetTcpReceiveBuffer(socket_handle);
+  if(NULL != receive_buffer) {
+    HashIndexRemove(&s_tcp_receive_buffer_index, (uint32_t) socket_handle,
+                    receive_buffer);
+    TcpReceiveBufferClear(receive_buffer);
+    g_network_status.tcp_connection_count--;
+  }
+  TcpSendQueue *send_queue = GetTcpSendQueue(socket_handle);
+  if(NULL != send_queue) {
+    HashIndexRemove(&s_tcp_send_queue_index, (uint32_t) socket_handle,
+                    send_queue);
+    TcpSendQueueClear(send_queue);
+  }
   CloseSocket(socket_handle);
 }
 
+/** @brief Queues the next inactivity check of a socket timer
+ *
+ * @param socket_timer The socket timer
+ * @param current_time The current time
+ * @param check_delay Time in milliseconds until the check
+ */
+static void ScheduleInactivityTimer(SocketTimer *const socket_timer,
+                                    const MicroSeconds current_time,
+                                    const MilliSeconds check_delay) {
+  if( !DeadlineQueueSchedule(&s_inactivity_timers,
+                             &socket_timer->inactivity_timer,
+                             current_time + check_delay * 1000ULL) ) {
+    OPENER_TRACE_ERR("inactivity timer queue full, timer not scheduled\n");
+  }
+}
+
+void AddSocketTimerToList(const int socket_handle) {
+  SocketTimer *socket_timer = SocketTimerIndexGet(&s_socket_timer_index,
+                                                  socket_handle);
+  if(NULL == socket_timer) {
+    socket_timer = SocketTimerArrayGetEmptySocketTimer(g_timestamps,
+                                                       OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
+    if(NULL == socket_timer) {
+      OPENER_TRACE_ERR("networkhandler: no socket timer left for socket %d\n",
+                       socket_handle);
+      return;
+    }
+    SocketTimerSetSocket(socket_timer, socket_handle);
+    SocketTimerIndexAdd(&s_socket_timer_index, socket_timer);
+  }
+  SocketTimerSetLastUpdate(socket_timer, g_actual_time);
+  if(0 < s_inactivity_timeout) {
+    ScheduleInactivityTimer(socket_timer, GetMicroSeconds(),
+                            1000UL * s_inactivity_timeout);
+  }
+}
+
 void RemoveSocketTimerFromList(const int socket_handle) {
-  SocketTimer *socket_timer = NULL;
-  while( NULL != ( socket_timer = SocketTimerArrayGetSocketTimer(g_timestamps,
-                                                                 OPENER_NUMBER_OF_SUPPORTED_SESSIONS,
-                                                                 socket_handle) ) )
-  {
+  SocketTimer *socket_timer = SocketTimerIndexRemove(&s_socket_timer_index,
+                                                     socket_handle);
+  if(NULL != socket_timer) {
+    DeadlineQueueCancel(&s_inactivity_timers, &socket_timer->inactivity_timer);
     SocketTimerClear(socket_timer);
   }
 }
 
 EipBool8 CheckSocketSet(int socket) {
-  EipBool8 return_value = false;
-  if( FD_ISSET(socket, &read_socket) ) {
-    if( FD_ISSET(socket, &master_socket) ) {
-      return_value = true;
-    } else {
-      OPENER_TRACE_INFO("socket: %d closed with pending message\n", socket);
+  for(int i = 0; i < ready_event_count; i++) {
+    if( (socket == ready_events[i].socket) &&
+        (ready_events[i].events & kNetworkEventReadable) ) {
+      /* remove it from the ready sockets so that later checks will not find it */
+      ready_events[i].events &= ~(unsigned int) kNetworkEventReadable;
+      return true;
+    }
+  }
+  return false;
+}
+
+/** @brief Accepts a pending TCP connection as non-blocking socket
+ *
+ * @return the new socket, kEipInvalidSocket if none is pending or on error
+ */
+static int AcceptTcpSocket(void) {
+#if defined(OPENER_HAVE_ACCEPT4)
+  return accept4(g_network_status.tcp_listener, NULL, NULL, SOCK_NONBLOCK);
+#else
+  while(true) {
+    int new_socket = accept(g_network_status.tcp_listener, NULL, NULL);
+    if(kEipInvalidSocket == new_socket ||
+       0 <= SetSocketToNonBlocking(new_socket) ) {
+      return new_socket;
     }
-    FD_CLR(socket, &read_socket);
-    /* remove it from the read set so that later checks will not find it */
+    OPENER_TRACE_ERR(
+      "networkhandler: error setting socket %d to non-blocking\n",
+      new_socket);
+    CloseSocketPlatform(new_socket);
+    g_network_status.rejected_tcp_connections++;
+  }
+#endif /* defined(OPENER_HAVE_ACCEPT4) */
+}
+
+/** @brief Sets up a newly accepted TCP socket
+ *
+ * @return kEipStatusError if the socket could not be set up
+ */
+static EipStatus SetUpAcceptedTcpSocket(const int new_socket) {
+  TcpReceiveBuffer *receive_buffer = TcpReceiveBufferArrayGetEmptyBuffer(
+    g_tcp_receive_buffers,
+    OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
+  TcpSendQueue *send_queue = TcpSendQueueArrayGetEmptyQueue(
+    g_tcp_send_queues,
+    OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
+  if(NULL == receive_buffer || NULL == send_queue) {
+    OPENER_TRACE_ERR(
+      "networkhandler: no %s left, closing new socket %d\n",
+      NULL == receive_buffer ? "receive buffer" : "send queue",
+      new_socket);
+    return kEipStatusError;
+  }
+
+  if( !HashIndexInsert(&s_tcp_receive_buffer_index, (uint32_t) new_socket,
+                        receive_buffer) ) {
+    OPENER_TRACE_ERR(
+      "networkhandler: receive buffer index full, closing new socket %d\n",
+      new_socket);
+    return kEipStatusError;
+  }
+  if( !HashIndexInsert(&s_tcp_send_queue_index, (uint32_t) new_socket,
+                        send_queue) ) {
+    OPENER_TRACE_ERR(
+      "networkhandler: send queue index full, closing new socket %d\n",
+      new_socket);
+    HashIndexRemove(&s_tcp_receive_buffer_index, (uint32_t) new_socket,
+                    receive_buffer);
+    return kEipStatusError;
   }
-  return return_value;
+  /* add newfd to the watched sockets */
+  if( kEipStatusOk !=
+      NetworkEventAddSocket(new_socket, kNetworkEventReadable) ) {
+    HashIndexRemove(&s_tcp_receive_buffer_index, (uint32_t) new_socket,
+                    receive_buffer);
+    HashIndexRemove(&s_tcp_send_queue_index, (uint32_t) new_socket,
+                    send_queue);
+    return kEipStatusError;
+  }
+  TcpReceiveBufferSetSocket(receive_buffer, new_socket);
+  TcpSendQueueSetSocket(send_queue, new_socket);
+  send_queue->watched_events = kNetworkEventReadable;
+  return kEipStatusOk;
 }
 
 void CheckAndHandleTcpListenerSocket(void) {
-  int new_socket = kEipInvalidSocket;
   /* see if this is a connection request to the TCP listener*/
   if( true == CheckSocketSet(g_network_status.tcp_listener) ) {
     OPENER_TRACE_INFO("networkhandler: new TCP connection\n");
 
-    new_socket = accept(g_network_status.tcp_listener, NULL, NULL);
-    if(new_socket == kEipInvalidSocket) {
-      int error_code = GetSocketErrorNumber();
-      char *error_message = GetErrorMessage(error_code);
-      OPENER_TRACE_ERR("networkhandler: error on accept: %d - %s\n",
-                       error_code, error_message);
-      FreeErrorMessage(error_message);
-      return;
-    } OPENER_TRACE_INFO(">>> network handler: accepting new TCP socket: %d \n",
-                        new_socket);
-
-    SocketTimer *socket_timer = SocketTimerArrayGetEmptySocketTimer(
-      g_timestamps,
-      OPENER_NUMBER_OF_SUPPORTED_SESSIONS);
-
-//    OPENER_TRACE_INFO("Current time stamp: %ld\n", g_actual_time);
-//    for(size_t i = 0; i < OPENER_NUMBER_OF_SUPPORTED_SESSIONS; i++) {
-//      OPENER_TRACE_INFO("Socket: %d - Last Update: %ld\n",
-//                        g_timestamps[i].socket,
-//                        g_timestamps[i].last_update);
-//    }
-
-    OPENER_ASSERT(socket_timer != NULL);
-
-    FD_SET(new_socket, &master_socket);
-    /* add newfd to master set */
-    if(new_socket > highest_socket_handle) {
-      OPENER_TRACE_INFO("New highest socket: %d\n", new_socket);
-      highest_socket_handle = new_socket;
-    }
+    /* drain the backlog, many peers may connect at the same time */
+    while(true) {
+      int new_socket = AcceptTcpSocket();
+      if(new_socket == kEipInvalidSocket) {
+        int error_code = GetSocketErrorNumber();
+        if(OPENER_SOCKET_WOULD_BLOCK != error_code) {
+          char *error_message = GetErrorMessage(error_code);
+          OPENER_TRACE_ERR("networkhandler: error on accept: %d - %s\n",
+                           error_code, error_message);
+          FreeErrorMessage(error_message);
+        }
+        return;
+      } OPENER_TRACE_INFO(">>> network handler: accepting new TCP socket: %d \n",
+                          new_socket);
+
+      if(OPENER_TCP_CONNECTION_LIMIT <= g_network_status.tcp_connection_count) {
+        OPENER_TRACE_WARN(
+          "networkhandler: TCP connection limit reached, closing new socket %d\n",
+          new_socket);
+        CloseSocketPlatform(new_socket);
+        g_network_status.rejected_tcp_connections++;
+        continue;
+      }
+
+      if( kEipStatusOk != SetUpAcceptedTcpSocket(new_socket) ) {
+        CloseSocketPlatform(new_socket);
+        g_network_status.rejected_tcp_connections++;
+        continue;
+      }
+      g_network_status.tcp_connection_count++;
+      g_network_status.accepted_tcp_connections++;
 
-    OPENER_TRACE_STATE("networkhandler: opened new TCP connection on fd %d\n",
-                       new_socket);
+      OPENER_TRACE_STATE("networkhandler: opened new TCP connection on fd %d\n",
+                         new_socket);
+    }
   }
 }
 
 EipStatus NetworkHandlerProcessCyclic(void) {
 
-  read_socket = master_socket;
-
-  g_time_value.tv_sec = 0;
-  g_time_value.tv_usec =
-    (g_network_status.elapsed_time <
-     kOpenerTimerTickInMilliSeconds ? kOpenerTimerTickInMilliSeconds -
-     g_network_status.elapsed_time : 0)
-    * 1000; /* 10 ms */
+  MilliSeconds time_to_next_tick =
+    g_network_status.elapsed_time < kOpenerTimerTickInMilliSeconds ?
+    kOpenerTimerTickInMilliSeconds - g_network_status.elapsed_time : 0;
+#ifdef OPENER_IO_THREAD
+  /* the connection timers are handled by the I/O thread */
+  MicroSeconds timeout = (MicroSeconds) time_to_next_tick * 1000ULL;
+#else
+#if defined(OPENER_IO_TIMESTAMPING)
+  HandleTransmitTimestamps();
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+  /* wake up for the next connection timer or the next tick of the periodic
+   * tasks, whatever comes first */
+  MicroSeconds timeout = PlanWakeUp(GetTimeToNextConnectionTimer(
+                                      GetMicroSeconds(),
+                                      (MicroSeconds)
+                                      time_to_next_tick *
+                                      1000ULL) );
+#endif
+  const bool explicit_messages_pending = s_explicit_messages_pending;
+  if(explicit_messages_pending) {
+    timeout = 0; /* continue with the deferred requests */
+  }
 
-  int ready_socket = select(highest_socket_handle + 1,
-                            &read_socket,
-                            0,
-                            0,
-                            &g_time_value);
+  int ready_socket = NetworkEventWait(timeout,
+                                      ready_events,
+                                      OPENER_NETWORK_EVENT_MAX_EVENTS);
+  ready_event_count = ready_socket > 0 ? ready_socket : 0;
+#ifndef OPENER_IO_THREAD
+  MeasureWakeUpLatency();
+#endif
 
   if(ready_socket == kEipInvalidSocket) {
-    if(EINTR == errno) /* we have somehow been interrupted. The default behavior is to go back into the select loop. */
+    if(EINTR == errno) /* we have somehow been interrupted. The default behavior is to go back into the event loop. */
     {
       return kEipStatusOk;
     } else {
       int error_code = GetSocketErrorNumber();
       char *error_message = GetErrorMessage(error_code);
-      OPENER_TRACE_ERR("networkhandler: error with select: %d - %s\n",
+      OPENER_TRACE_ERR("networkhandler: error waiting for network events: %d - %s\n",
                        error_code,
                        error_message);
       FreeErrorMessage(error_message);
@@ -484,28 +1138,22 @@ EipStatus NetworkHandlerProcessCyclic(void) {
     }
   }
 
-  if(ready_socket > 0) {
+#ifdef OPENER_IO_THREAD
+  LockStack();
+#endif
 
-    CheckAndHandleTcpListenerSocket();
-    CheckAndHandleUdpUnicastSocket();
-    CheckAndHandleUdpGlobalBroadcastSocket();
+  if(ready_socket > 0 || explicit_messages_pending) {
+#ifndef OPENER_IO_THREAD
+    /* implicit I/O has priority, consumed data and due productions are
+     * handled before any explicit message */
     CheckAndHandleConsumingUdpSocket();
-
-    for(int socket = 0; socket <= highest_socket_handle; socket++) {
-      if( true == CheckSocketSet(socket) ) {
-        /* if it is still checked it is a TCP receive */
-        if( kEipStatusError == HandleDataOnTcpSocket(socket) ) /* if error */
-        {
-          CloseTcpSocket(socket);
-          RemoveSession(socket); /* clean up session and close the socket */
-        }
-      }
-    }
+    ManageConnectionTimers(GetMicroSeconds() );
+#endif
+    HandleExplicitMessaging();
   }
+  ready_event_count = 0;
 
-  for(int socket = 0; socket <= highest_socket_handle; socket++) {
-    CheckEncapsulationInactivity(socket);
-  }
+  CheckEncapsulationInactivity();
 
   /* Check if all connections from one originator times out */
   //CheckForTimedOutConnectionsAndCloseTCPConnections();
@@ -531,30 +1179,189 @@ EipStatus NetworkHandlerProcessCyclic(void) {
 
     g_network_status.elapsed_time = 0;
   }
+
+#ifdef OPENER_IO_THREAD
+  WakeIoThreadIfNeeded();
+  UnlockStack();
+#else
+  /* production and inactivity watchdogs of the connections */
+  ManageConnectionTimers(GetMicroSeconds() );
+#endif
   return kEipStatusOk;
 }
 
-EipStatus NetworkHandlerFinish(void) {
-  CloseTcpSocket(g_network_status.tcp_listener);
-  CloseUdpSocket(g_network_status.udp_unicast_listener);
-  CloseUdpSocket(g_network_status.udp_global_broadcast_listener);
-  return kEipStatusOk;
+/** @brief Checks if the explicit messaging of the current cycle has to stop
+ */
+static bool IsExplicitMessagingBudgetUsedUp(void) {
+  return 0 != g_network_status.explicit_time_budget &&
+         GetMicroSeconds() >= s_explicit_messaging_deadline;
 }
 
-void CheckAndHandleUdpGlobalBroadcastSocket(void) {
-  /* see if this is an unsolicited inbound UDP message */
-  if( true == CheckSocketSet(g_network_status.udp_global_broadcast_listener) ) {
-    struct sockaddr_in from_address = { 0 };
-    socklen_t from_address_length = sizeof(from_address);
+/** @brief Checks if a TCP session has buffered requests it can handle now
+ *
+ * @param receive_buffer The receive buffer of the session
+ * @return true if complete requests are buffered and the send queue can take
+ *  a reply
+ */
+static bool HasBufferedExplicitMessages(
+  const TcpReceiveBuffer *const receive_buffer) {
+  const TcpSendQueue *const send_queue = GetTcpSendQueue(
+    receive_buffer->socket);
+  return NULL != send_queue && TcpSendQueueCanTakeMessage(send_queue) &&
+         TcpReceiveBufferHasMessage(receive_buffer);
+}
 
-    OPENER_TRACE_STATE(
+/** @brief Adds a TCP session to the sessions of the current cycle, a session
+ * is listed once with all its events
+ *
+ * @param socket The socket, ignored if it is no TCP session
+ * @param events The events reported for the socket
+ * @param slots The slots of the listed sessions in g_tcp_receive_buffers
+ * @param number_of_slots The number of listed sessions
+ */
+static void ListTcpSession(const int socket,
+                           const unsigned int events,
+                           size_t *const slots,
+                           size_t *const number_of_slots) {
+  const TcpReceiveBuffer *const receive_buffer = GetTcpReceiveBuffer(socket);
+  if(NULL == receive_buffer) {
+    return; /* a listener or a session closed in the meantime */
+  }
+  const size_t slot = (size_t) (receive_buffer - g_tcp_receive_buffers);
+  s_tcp_session_events[slot] |= events;
+  if(!s_tcp_session_is_listed[slot]) {
+    s_tcp_session_is_listed[slot] = true;
+    slots[(*number_of_slots)++] = slot;
+  }
+}
+
+/** @brief Serves the TCP sessions deferred in the earlier cycles followed by
+ * the ready ones until the time budget is used up, the sessions not served
+ * are deferred to the next cycle in their order
+ *
+ * At least one session is served per cycle, so every session makes progress
+ * even if the budget is already used up by the UDP requests. A served session
+ * whose buffered requests were cut short by the budget is deferred behind
+ * the sessions not served.
+ */
+static void HandleTcpSessions(void) {
+  size_t slots[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+  size_t number_of_slots = 0;
+  for(size_t i = 0; i < s_number_of_deferred_sessions; i++) {
+    ListTcpSession(s_deferred_sessions[i], kNetworkEventNone, slots,
+                   &number_of_slots);
+  }
+  for(int i = 0; i < ready_event_count; i++) {
+    if(kNetworkEventNone != ready_events[i].events) {
+      ListTcpSession(ready_events[i].socket, ready_events[i].events, slots,
+                     &number_of_slots);
+      ready_events[i].events = kNetworkEventNone;
+    }
+  }
+  s_number_of_deferred_sessions = 0;
+
+  int resumed_sessions[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+  size_t number_of_resumed_sessions = 0;
+  bool session_served = false;
+  for(size_t i = 0; i < number_of_slots; i++) {
+    const size_t slot = slots[i];
+    const unsigned int events = s_tcp_session_events[slot];
+    s_tcp_session_events[slot] = kNetworkEventNone;
+    s_tcp_session_is_listed[slot] = false;
+    TcpReceiveBuffer *const receive_buffer = &g_tcp_receive_buffers[slot];
+    const int socket = receive_buffer->socket;
+    if(kEipInvalidSocket == socket) {
+      continue; /* closed by a request of another session */
+    }
+
+    if(session_served && IsExplicitMessagingBudgetUsedUp() ) {
+      if(kNetworkEventNone != events ||
+         HasBufferedExplicitMessages(receive_buffer) ) {
+        s_deferred_sessions[s_number_of_deferred_sessions++] = socket;
+        g_network_status.deferred_explicit_sessions++;
+        s_explicit_messages_pending = true;
+      }
+      continue;
+    }
+
+    session_served = true;
+    EipStatus status = kEipStatusOk;
+    /* requests buffered in an earlier cycle are resumed like after a send
+     * queue was flushed */
+    if( (events & kNetworkEventWritable) ||
+        ( !(events & kNetworkEventReadable) &&
+          TcpReceiveBufferHasMessage(receive_buffer) ) ) {
+      status = HandleWritableTcpSocket(socket);
+    }
+    if(kEipStatusOk == status && (events & kNetworkEventReadable) &&
+       socket == receive_buffer->socket) {
+      status = HandleDataOnTcpSocket(socket);
+    }
+    if(kEipStatusError == status) {
+      CloseTcpSocket(socket);
+      RemoveSession(socket); /* clean up session and close the socket */
+    } else if(socket == receive_buffer->socket &&
+              HasBufferedExplicitMessages(receive_buffer) ) {
+      resumed_sessions[number_of_resumed_sessions++] = socket;
+    }
+  }
+
+  for(size_t i = 0; i < number_of_resumed_sessions; i++) {
+    s_deferred_sessions[s_number_of_deferred_sessions++] = resumed_sessions[i];
+    s_explicit_messages_pending = true;
+  }
+}
+
+static void HandleExplicitMessaging(void) {
+  s_explicit_messaging_deadline = GetMicroSeconds() +
+                                  g_network_status.explicit_time_budget;
+  s_explicit_messages_pending = false;
+
+  CheckAndHandleTcpListenerSocket();
+  CheckAndHandleUdpUnicastSocket();
+  CheckAndHandleUdpGlobalBroadcastSocket();
+  HandleTcpSessions();
+
+  if(0 != g_network_status.explicit_time_budget &&
+     GetMicroSeconds() > s_explicit_messaging_deadline) {
+    g_network_status.explicit_budget_overruns++;
+  }
+}
+
+EipStatus NetworkHandlerFinish(void) {
+  CloseTcpSocket(g_network_status.tcp_listener);
+  CloseUdpSocket(g_network_status.udp_unicast_listener);
+  CloseUdpSocket(g_network_status.udp_global_broadcast_listener);
+  NetworkEventFinish();
+#ifdef OPENER_IO_THREAD
+  close(s_io_thread_wake_pipe[0]);
+  close(s_io_thread_wake_pipe[1]);
+  s_io_thread_wake_pipe[0] = s_io_thread_wake_pipe[1] = -1;
+  pthread_mutex_destroy(&s_stack_lock);
+  CipFree(s_io_thread_sockets);
+  s_io_thread_sockets = NULL;
+  CipFree(s_consuming_sockets);
+  s_consuming_sockets = NULL;
+  s_number_of_consuming_sockets = 0;
+  s_io_thread_max_sockets = 0;
+  s_io_thread_watched_sockets = 0;
+#endif
+  return kEipStatusOk;
+}
+
+void CheckAndHandleUdpGlobalBroadcastSocket(void) {
+  /* see if this is an unsolicited inbound UDP message */
+  if( true == CheckSocketSet(g_network_status.udp_global_broadcast_listener) ) {
+    struct sockaddr_in from_address = { 0 };
+    socklen_t from_address_length = sizeof(from_address);
+
+    OPENER_TRACE_STATE(
       "networkhandler: unsolicited UDP message on EIP global broadcast socket\n");
 
     /* Handle UDP broadcast messages */
-    CipOctet incoming_message[PC_OPENER_ETHERNET_BUFFER_SIZE] = { 0 };
     int received_size = recvfrom(g_network_status.udp_global_broadcast_listener,
-                                 NWBUF_CAST incoming_message,
-                                 sizeof(incoming_message),
+                                 NWBUF_CAST s_udp_receive_buffer,
+                                 sizeof(s_udp_receive_buffer),
                                  0,
                                  (struct sockaddr *) &from_address,
                                  &from_address_length);
@@ -572,7 +1379,7 @@ void CheckAndHandleUdpGlobalBroadcastSocket(void) {
 
     OPENER_TRACE_INFO("Data received on global broadcast UDP:\n");
 
-    const EipUint8 *receive_buffer = &incoming_message[0];
+    const EipUint8 *receive_buffer = &s_udp_receive_buffer[0];
     int remaining_bytes = 0;
     ENIPMessage outgoing_message;
     InitializeENIPMessage(&outgoing_message);
@@ -620,10 +1427,9 @@ void CheckAndHandleUdpUnicastSocket(void) {
       "networkhandler: unsolicited UDP message on EIP unicast socket\n");
 
     /* Handle UDP broadcast messages */
-    CipOctet incoming_message[PC_OPENER_ETHERNET_BUFFER_SIZE] = { 0 };
     int received_size = recvfrom(g_network_status.udp_unicast_listener,
-                                 NWBUF_CAST incoming_message,
-                                 sizeof(incoming_message),
+                                 NWBUF_CAST s_udp_receive_buffer,
+                                 sizeof(s_udp_receive_buffer),
                                  0,
                                  (struct sockaddr *) &from_address,
                                  &from_address_length);
@@ -641,7 +1447,7 @@ void CheckAndHandleUdpUnicastSocket(void) {
 
     OPENER_TRACE_INFO("Data received on UDP unicast:\n");
 
-    EipUint8 *receive_buffer = &incoming_message[0];
+    EipUint8 *receive_buffer = &s_udp_receive_buffer[0];
     int remaining_bytes = 0;
     ENIPMessage outgoing_message;
     InitializeENIPMessage(&outgoing_message);
@@ -679,36 +1485,43 @@ void CheckAndHandleUdpUnicastSocket(void) {
   }
 }
 
-EipStatus SendUdpData(const struct sockaddr_in *const address,
-                      const ENIPMessage
-                      *const outgoing_message) {
-
-#if defined(OPENER_TRACE_ENABLED)
-  static char ip_str[INET_ADDRSTRLEN];
-  OPENER_TRACE_INFO(
-    "UDP packet to be sent to: %s:%d\n",
-    inet_ntop(AF_INET, &address->sin_addr, ip_str, sizeof ip_str),
-    ntohs(address->sin_port) );
-#endif
-
-  int sent_length = sendto( g_network_status.udp_io_messaging,
-                            (char *)outgoing_message->message_buffer,
-                            outgoing_message->used_message_length, 0,
-                            (struct sockaddr *) address, sizeof(*address) );
+/** @brief Sends a message on a UDP socket
+ *
+ *  @param socket The socket to send on
+ *  @param address The receiver, NULL for a connected socket
+ *  @param outgoing_message The message to be sent
+ *  @return kEipStatusOk if the whole message was sent, kEipStatusError
+ *  otherwise
+ */
+static EipStatus SendUdpMessage(const int socket,
+                                const struct sockaddr_in *const address,
+                                const ENIPMessage *const outgoing_message) {
+  const long sent_length = NULL == address ?
+                           send(socket,
+                                (char *)outgoing_message->message_buffer,
+                                outgoing_message->used_message_length,
+                                MSG_NOSIGNAL) :
+                           sendto(socket,
+                                  (char *)outgoing_message->message_buffer,
+                                  outgoing_message->used_message_length, 0,
+                                  (struct sockaddr *) address,
+                                  sizeof(*address) );
   if(sent_length < 0) {
     int error_code = GetSocketErrorNumber();
     char *error_message = GetErrorMessage(error_code);
     OPENER_TRACE_ERR(
-      "networkhandler: error with sendto in SendUDPData: %d - %s\n",
+      "networkhandler: error sending UDP data on socket %d: %d - %s\n",
+      socket,
       error_code,
       error_message);
     FreeErrorMessage(error_message);
     return kEipStatusError;
   }
 
-  if(sent_length != outgoing_message->used_message_length) {
+  if( (size_t) sent_length != outgoing_message->used_message_length ) {
     OPENER_TRACE_WARN(
-      "data length sent_length mismatch; probably not all data was sent in SendUdpData, sent %d of %d\n",
+      "data length sent_length mismatch; probably not all data was sent on socket %d, sent %ld of %" PRIuSZT "\n",
+      socket,
       sent_length,
       outgoing_message->used_message_length);
     return kEipStatusError;
@@ -717,196 +1530,421 @@ EipStatus SendUdpData(const struct sockaddr_in *const address,
   return kEipStatusOk;
 }
 
-EipStatus HandleDataOnTcpSocket(int socket) {
-  OPENER_TRACE_INFO("Entering HandleDataOnTcpSocket for socket: %d\n", socket);
-  int remaining_bytes = 0;
-  long data_sent = PC_OPENER_ETHERNET_BUFFER_SIZE;
+EipStatus SendUdpData(const struct sockaddr_in *const address,
+                      const ENIPMessage
+                      *const outgoing_message) {
 
-  /* We will handle just one EIP packet here the rest is done by the select
-   * method which will inform us if more data is available in the socket
-     because of the current implementation of the main loop this may not be
-     the fastest way and a loop here with a non blocking socket would better
-     fit*/
+#if defined(OPENER_TRACE_ENABLED)
+  static char ip_str[INET_ADDRSTRLEN];
+  OPENER_TRACE_INFO(
+    "UDP packet to be sent to: %s:%d\n",
+    inet_ntop(AF_INET, &address->sin_addr, ip_str, sizeof ip_str),
+    ntohs(address->sin_port) );
+#endif
 
-  /*Check how many data is here -- read the first four bytes from the connection */
-  CipOctet incoming_message[PC_OPENER_ETHERNET_BUFFER_SIZE] = { 0 };
+  return SendUdpMessage(g_network_status.udp_io_messaging, address,
+                        outgoing_message);
+}
 
-  long number_of_read_bytes = recv(socket, NWBUF_CAST incoming_message, 4, 0); /*TODO we may have to set the socket to a non blocking socket */
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+EipStatus SendConnectedUdpData(const int socket,
+                               const ENIPMessage *const outgoing_message) {
+  return SendUdpMessage(socket, NULL, outgoing_message);
+}
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
+
+void SendUdpDataBatch(UdpDataBatchEntry *const batch,
+                      const size_t number_of_messages) {
+#if defined(OPENER_HAVE_SENDMMSG)
+  /* the message and its payload of each entry */
+  struct iovec io_vectors[OPENER_UDP_SEND_BATCH_SIZE][2];
+  struct mmsghdr messages[OPENER_UDP_SEND_BATCH_SIZE];
+
+  size_t processed_messages = 0;
+  while(processed_messages < number_of_messages) {
+    UdpDataBatchEntry *const pending = &batch[processed_messages];
+    size_t number_of_pending = number_of_messages - processed_messages;
+    if(OPENER_UDP_SEND_BATCH_SIZE < number_of_pending) {
+      number_of_pending = OPENER_UDP_SEND_BATCH_SIZE;
+    }
+    /* one system call sends the following messages of the same socket */
+    for(size_t i = 1; i < number_of_pending; i++) {
+      if(pending[i].socket != pending[0].socket) {
+        number_of_pending = i;
+        break;
+      }
+    }
+    const bool is_connected = kEipInvalidSocket != pending[0].socket;
+
+    memset( messages, 0, sizeof(messages) );
+    for(size_t i = 0; i < number_of_pending; i++) {
+      io_vectors[i][0].iov_base = pending[i].message.message_buffer;
+      io_vectors[i][0].iov_len = pending[i].message.used_message_length;
+      io_vectors[i][1].iov_base = (void *) pending[i].payload;
+      io_vectors[i][1].iov_len = pending[i].payload_length;
+      messages[i].msg_hdr.msg_iov = io_vectors[i];
+      messages[i].msg_hdr.msg_iovlen = 0 == pending[i].payload_length ? 1 : 2;
+      if(!is_connected) {
+        messages[i].msg_hdr.msg_name = &pending[i].address;
+        messages[i].msg_hdr.msg_namelen = sizeof(pending[i].address);
+      }
+    }
 
-  SocketTimer *const socket_timer = SocketTimerArrayGetSocketTimer(g_timestamps,
-                                                                   OPENER_NUMBER_OF_SUPPORTED_SESSIONS,
-                                                                   socket);
-  if(number_of_read_bytes == 0) {
-    OPENER_TRACE_ERR(
-      "networkhandler: socket: %d - connection closed by client.\n",
-      socket);
-    RemoveSocketTimerFromList(socket);
-    RemoveSession(socket);
-    return kEipStatusError;
+    const int socket = is_connected ? pending[0].socket :
+                       g_network_status.udp_io_messaging;
+    int sent_messages = sendmmsg(socket,
+                                 messages,
+                                 (unsigned int) number_of_pending,
+                                 MSG_NOSIGNAL);
+    if(0 > sent_messages) {
+      /* the first pending message failed, continue with the next one */
+      int error_code = GetSocketErrorNumber();
+      char *error_message = GetErrorMessage(error_code);
+      OPENER_TRACE_ERR(
+        "networkhandler: error with sendmmsg in SendUdpDataBatch: %d - %s\n",
+        error_code,
+        error_message);
+      FreeErrorMessage(error_message);
+      pending[0].send_status = kEipStatusError;
+      processed_messages++;
+      continue;
+    }
+
+    for(int i = 0; i < sent_messages; i++) {
+      pending[i].send_status = kEipStatusOk;
+#if defined(OPENER_IO_TIMESTAMPING)
+      IoTimestampingNoteSent(socket,
+                             pending[i].connection_id,
+                             pending[i].production_deadline);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+      const size_t message_length = pending[i].message.used_message_length +
+                                    pending[i].payload_length;
+      if(messages[i].msg_len != message_length) {
+        OPENER_TRACE_WARN(
+          "data length sent_length mismatch; probably not all data was sent in SendUdpDataBatch, sent %u of %" PRIuSZT "\n",
+          messages[i].msg_len,
+          message_length);
+        pending[i].send_status = kEipStatusError;
+      }
+    }
+    processed_messages += (size_t) sent_messages;
   }
-  if(number_of_read_bytes < 0) {
-    int error_code = GetSocketErrorNumber();
-    if(OPENER_SOCKET_WOULD_BLOCK == error_code) {
-      return kEipStatusOk;
+#else
+  for(size_t i = 0; i < number_of_messages; i++) {
+    /* the payload is sent as part of the message */
+    ENIPMessage *const message = &batch[i].message;
+    if(sizeof(message->message_buffer) - message->used_message_length <
+       batch[i].payload_length) {
+      OPENER_TRACE_ERR(
+        "networkhandler: payload of %" PRIuSZT " bytes exceeds the message buffer in SendUdpDataBatch\n",
+        batch[i].payload_length);
+      batch[i].send_status = kEipStatusError;
+      continue;
     }
-    char *error_message = GetErrorMessage(error_code);
-    OPENER_TRACE_ERR("networkhandler: error on recv: %d - %s\n",
-                     error_code,
-                     error_message);
-    FreeErrorMessage(error_message);
+    if(0 != batch[i].payload_length) {
+      memcpy(message->current_message_position, batch[i].payload,
+             batch[i].payload_length);
+      message->current_message_position += batch[i].payload_length;
+      message->used_message_length += batch[i].payload_length;
+      batch[i].payload_length = 0;
+    }
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+    if(kEipInvalidSocket != batch[i].socket) {
+      batch[i].send_status = SendConnectedUdpData(batch[i].socket,
+                                                  &batch[i].message);
+      continue;
+    }
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
+    batch[i].send_status = SendUdpData(&batch[i].address, &batch[i].message);
+#if defined(OPENER_IO_TIMESTAMPING)
+    if(kEipStatusOk == batch[i].send_status) {
+      IoTimestampingNoteSent(g_network_status.udp_io_messaging,
+                             batch[i].connection_id,
+                             batch[i].production_deadline);
+    }
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+  }
+#endif /* defined(OPENER_HAVE_SENDMMSG) */
+}
+
+/** @brief Watches a TCP socket for the events matching its send queue
+ *
+ *  Requests are only read while the send queue can take their replies, the
+ *  socket is watched for writability while the send queue is not empty.
+ */
+static EipStatus UpdateTcpSocketEvents(const int socket,
+                                       TcpSendQueue *const send_queue) {
+  unsigned int events = kNetworkEventNone;
+  if( TcpSendQueueCanTakeMessage(send_queue) ) {
+    events |= kNetworkEventReadable;
+  }
+  if( !TcpSendQueueIsEmpty(send_queue) ) {
+    events |= kNetworkEventWritable;
+  }
+  if(events == send_queue->watched_events) {
+    return kEipStatusOk;
+  }
+  OPENER_TRACE_INFO("networkhandler: socket %d watched for events 0x%x\n",
+                    socket,
+                    events);
+  send_queue->watched_events = events;
+  return NetworkEventModifySocket(socket, events);
+}
+
+/** @brief Sends a reply on a TCP socket, the bytes the socket does not take
+ *  are queued behind the already queued ones
+ *
+ *  @return kEipStatusError if the socket failed or the send queue overflowed
+ */
+static EipStatus SendOnTcpSocket(const int socket,
+                                 const CipOctet *const data,
+                                 const size_t data_length) {
+  TcpSendQueue *const send_queue = GetTcpSendQueue(socket);
+  if(NULL == send_queue) {
+    OPENER_TRACE_ERR("networkhandler: no send queue for socket %d\n", socket);
     return kEipStatusError;
   }
 
-  const EipUint8 *read_buffer = &incoming_message[2]; /* at this place EIP stores the data length */
-  size_t data_size = GetUintFromMessage(&read_buffer) +
-                     ENCAPSULATION_HEADER_LENGTH - 4; /* -4 is for the 4 bytes we have already read*/
-  /* (NOTE this advances the buffer pointer) */
-  if( (PC_OPENER_ETHERNET_BUFFER_SIZE - 4) < data_size ) { /*TODO can this be handled in a better way?*/
-    OPENER_TRACE_ERR(
-      "too large packet received will be ignored, will drop the data\n");
-    /* Currently we will drop the whole packet */
-
-    do {
-      OPENER_TRACE_INFO(
-        "Entering consumption loop, remaining data to receive: %ld\n",
-        data_sent);
-      number_of_read_bytes = recv(socket,
-                                  NWBUF_CAST & incoming_message[0],
-                                  data_sent,
-                                  0);
-
-      if(number_of_read_bytes == 0) /* got error or connection closed by client */
-      {
-        int error_code = GetSocketErrorNumber();
-        char *error_message = GetErrorMessage(error_code);
-        OPENER_TRACE_ERR(
-          "networkhandler: socket: %d - connection closed by client: %d - %s\n",
-          socket,
-          error_code,
-          error_message);
-        FreeErrorMessage(error_message);
-        RemoveSocketTimerFromList(socket);
-        return kEipStatusError;
-      }
-      if(number_of_read_bytes < 0) {
-        int error_code = GetSocketErrorNumber();
+  size_t data_sent = 0;
+  if( TcpSendQueueIsEmpty(send_queue) ) {
+    long sent_length = send(socket, (const char *) data, data_length,
+                            MSG_NOSIGNAL);
+    if(sent_length < 0) {
+      int error_code = GetSocketErrorNumber();
+      if(OPENER_SOCKET_WOULD_BLOCK != error_code) {
         char *error_message = GetErrorMessage(error_code);
-        if(OPENER_SOCKET_WOULD_BLOCK == error_code) {
-          return kEipStatusOk;
-        } OPENER_TRACE_ERR("networkhandler: error on recv: %d - %s\n",
-                           error_code,
-                           error_message);
+        OPENER_TRACE_ERR("networkhandler: error on send: %d - %s\n",
+                         error_code,
+                         error_message);
         FreeErrorMessage(error_message);
         return kEipStatusError;
       }
-      data_size -= number_of_read_bytes;
-      if( (data_size < PC_OPENER_ETHERNET_BUFFER_SIZE) && (data_size != 0) ) {
-        data_sent = data_size;
-      }
-    } while(0 < data_size);
-    SocketTimerSetLastUpdate(socket_timer, g_actual_time);
-    return kEipStatusOk;
+      sent_length = 0;
+    }
+    data_sent = (size_t) sent_length;
   }
 
-  number_of_read_bytes = recv(socket,
-                              NWBUF_CAST & incoming_message[4],
-                              data_size,
-                              0);
+  if(data_sent < data_length) {
+    OPENER_TRACE_INFO("TCP reply: %" PRIuSZT " bytes queued on %d\n",
+                      data_length - data_sent,
+                      socket);
+    if( kEipStatusOk !=
+        TcpSendQueueAppend(send_queue, &data[data_sent],
+                           data_length - data_sent) ) {
+      OPENER_TRACE_ERR("networkhandler: send queue of socket %d overflowed\n",
+                       socket);
+      return kEipStatusError;
+    }
+    return UpdateTcpSocketEvents(socket, send_queue);
+  }
+  return kEipStatusOk;
+}
 
-  if(0 == number_of_read_bytes) /* got error or connection closed by client */
+/** @brief Handles the complete messages in the receive buffer of a TCP socket
+ *
+ *  Stops while the send queue of the socket cannot take another reply, the
+ *  remaining messages are handled when the queue has room again.
+ */
+static EipStatus HandleTcpReceiveBufferMessages(const int socket,
+                                                TcpReceiveBuffer *const
+                                                receive_buffer,
+                                                const TcpSendQueue *const
+                                                send_queue) {
+  CipOctet *message = NULL;
+  size_t message_size = 0;
+  while( TcpSendQueueCanTakeMessage(send_queue) &&
+         0 != ( message_size =
+                  TcpReceiveBufferGetMessage(receive_buffer, &message,
+                                             PC_OPENER_ETHERNET_BUFFER_SIZE) ) )
   {
-    int error_code = GetSocketErrorNumber();
-    char *error_message = GetErrorMessage(error_code);
-    OPENER_TRACE_ERR(
-      "networkhandler: socket: %d - connection closed by client: %d - %s\n",
-      socket,
-      error_code,
-      error_message);
-    FreeErrorMessage(error_message);
-    RemoveSocketTimerFromList(socket);
-    RemoveSession(socket);
-    return kEipStatusError;
-  }
-  if(number_of_read_bytes < 0) {
-    int error_code = GetSocketErrorNumber();
-    char *error_message = GetErrorMessage(error_code);
-    if(OPENER_SOCKET_WOULD_BLOCK == error_code) {
+    if( kEipStatusOk !=
+        HandleEncapsulationMessageOnTcpSocket(socket, message,
+                                              message_size) ) {
+      return kEipStatusError;
+    }
+    if(socket != receive_buffer->socket) {
+      /* the session has been closed by the request, e.g., UnregisterSession */
       return kEipStatusOk;
-    } OPENER_TRACE_ERR("networkhandler: error on recv: %d - %s\n",
-                       error_code,
-                       error_message);
-    FreeErrorMessage(error_message);
+    }
+    TcpReceiveBufferConsume(receive_buffer, message_size);
+    if( IsExplicitMessagingBudgetUsedUp() ) {
+      /* the further requests are handled in the next cycle */
+      if( TcpReceiveBufferHasMessage(receive_buffer) ) {
+        s_explicit_messages_pending = true;
+      }
+      return kEipStatusOk;
+    }
+  }
+  return kEipStatusOk;
+}
+
+EipStatus HandleDataOnTcpSocket(int socket) {
+  OPENER_TRACE_INFO("Entering HandleDataOnTcpSocket for socket: %d\n", socket);
+
+  TcpReceiveBuffer *const receive_buffer = GetTcpReceiveBuffer(socket);
+  const TcpSendQueue *const send_queue = GetTcpSendQueue(socket);
+  if(NULL == receive_buffer || NULL == send_queue) {
+    OPENER_TRACE_ERR("networkhandler: no receive buffer for socket %d\n",
+                     socket);
     return kEipStatusError;
   }
 
-  if( (unsigned) number_of_read_bytes == data_size ) {
-    /*we got the right amount of data */
-    data_size += 4;
-    /*TODO handle partial packets*/
-    OPENER_TRACE_INFO("Data received on TCP: %" PRIuSZT "\n", data_size);
+  /* Read until the socket is drained, partial messages stay in the receive
+   * buffer until the rest arrives, every complete message is handled at once.
+   * Reading pauses while the replies are not taken by the peer.
+   */
+  while( TcpSendQueueCanTakeMessage(send_queue) ) {
+    size_t free_space = 0;
+    CipOctet *const write_position = TcpReceiveBufferGetWritePosition(
+      receive_buffer,
+      &free_space);
+    OPENER_ASSERT(0 < free_space); /* complete messages are always consumed */
 
-    g_current_active_tcp_socket = socket;
+    long number_of_read_bytes = recv(socket,
+                                     NWBUF_CAST write_position,
+                                     free_space,
+                                     0);
 
-    struct sockaddr sender_address;
-    memset( &sender_address, 0, sizeof(sender_address) );
-    socklen_t fromlen = sizeof(sender_address);
-    if(getpeername(socket, (struct sockaddr *) &sender_address, &fromlen) < 0) {
+    if(0 == number_of_read_bytes) /* got error or connection closed by client */
+    {
+      OPENER_TRACE_ERR(
+        "networkhandler: socket: %d - connection closed by client.\n",
+        socket);
+      RemoveSocketTimerFromList(socket);
+      RemoveSession(socket);
+      return kEipStatusError;
+    }
+    if(number_of_read_bytes < 0) {
       int error_code = GetSocketErrorNumber();
+      if(OPENER_SOCKET_WOULD_BLOCK == error_code) {
+        return kEipStatusOk;
+      }
       char *error_message = GetErrorMessage(error_code);
-      OPENER_TRACE_ERR("networkhandler: could not get peername: %d - %s\n",
+      OPENER_TRACE_ERR("networkhandler: error on recv: %d - %s\n",
                        error_code,
                        error_message);
       FreeErrorMessage(error_message);
+      return kEipStatusError;
     }
 
-    ENIPMessage outgoing_message;
-    InitializeENIPMessage(&outgoing_message);
-    EipStatus need_to_send = HandleReceivedExplictTcpData(socket,
-                                                          incoming_message,
-                                                          data_size,
-                                                          &remaining_bytes,
-                                                          &sender_address,
-                                                          &outgoing_message);
-    if(NULL != socket_timer) {
-      SocketTimerSetLastUpdate(socket_timer, g_actual_time);
-    }
+    TcpReceiveBufferCommit(receive_buffer, (size_t) number_of_read_bytes);
+    SocketTimerSetLastUpdate(SocketTimerIndexGet(&s_socket_timer_index,
+                                                 socket),
+                             g_actual_time);
 
-    g_current_active_tcp_socket = kEipInvalidSocket;
+    if( kEipStatusOk !=
+        HandleTcpReceiveBufferMessages(socket, receive_buffer, send_queue) ) {
+      return kEipStatusError;
+    }
+    if(socket != receive_buffer->socket) {
+      return kEipStatusOk; /* the session has been closed by a request */
+    }
 
-    if(remaining_bytes != 0) {
-      OPENER_TRACE_WARN(
-        "Warning: received packet was to long: %d Bytes left!\n",
-        remaining_bytes);
+    if( (size_t) number_of_read_bytes < free_space ) {
+      return kEipStatusOk; /* the socket is drained */
     }
+    if( IsExplicitMessagingBudgetUsedUp() ) {
+      return kEipStatusOk; /* still readable, read on in the next cycle */
+    }
+  }
+  return kEipStatusOk;
+}
 
-    if(need_to_send > 0) {
-      OPENER_TRACE_INFO("TCP reply: send %" PRIuSZT " bytes on %d\n",
-                        outgoing_message.used_message_length,
-                        socket);
-
-      data_sent = send(socket,
-                       (char *) outgoing_message.message_buffer,
-                       outgoing_message.used_message_length,
-                       MSG_NOSIGNAL);
-      SocketTimerSetLastUpdate(socket_timer, g_actual_time);
-      if(data_sent != outgoing_message.used_message_length) {
-        OPENER_TRACE_WARN(
-          "TCP response was not fully sent: exp %" PRIuSZT ", sent %ld\n",
-          outgoing_message.used_message_length,
-          data_sent);
+EipStatus HandleWritableTcpSocket(const int socket) {
+  TcpSendQueue *const send_queue = GetTcpSendQueue(socket);
+  TcpReceiveBuffer *const receive_buffer = GetTcpReceiveBuffer(socket);
+  if(NULL == send_queue || NULL == receive_buffer) {
+    return kEipStatusOk; /* closed in the meantime */
+  }
+
+  size_t data_length = 0;
+  const CipOctet *const data = TcpSendQueueGetData(send_queue, &data_length);
+  if(0 < data_length) {
+    long data_sent = send(socket, (const char *) data, data_length,
+                          MSG_NOSIGNAL);
+    if(data_sent < 0) {
+      int error_code = GetSocketErrorNumber();
+      if(OPENER_SOCKET_WOULD_BLOCK == error_code) {
+        return kEipStatusOk;
       }
+      char *error_message = GetErrorMessage(error_code);
+      OPENER_TRACE_ERR("networkhandler: error on send: %d - %s\n",
+                       error_code,
+                       error_message);
+      FreeErrorMessage(error_message);
+      return kEipStatusError;
     }
+    OPENER_TRACE_INFO("TCP reply: sent %ld queued bytes on %d\n",
+                      data_sent,
+                      socket);
+    TcpSendQueueConsume(send_queue, (size_t) data_sent);
+    SocketTimerSetLastUpdate(SocketTimerIndexGet(&s_socket_timer_index,
+                                                 socket),
+                             g_actual_time);
+  }
 
-    return kEipStatusOk;
-  } else {
-    /* we got a fragmented packet currently we cannot handle this will
-     * for this we would need a network buffer per TCP socket
-     *
-     * However with typical packet sizes of EIP this shouldn't be a big issue.
-     */
-    /*TODO handle fragmented packets */
-  }
-  return kEipStatusError;
+  /* requests received while the queue was full are handled now, further
+   * ones are read when the socket is reported readable again */
+  if( kEipStatusOk !=
+      HandleTcpReceiveBufferMessages(socket, receive_buffer, send_queue) ) {
+    return kEipStatusError;
+  }
+  if(socket != send_queue->socket) {
+    return kEipStatusOk; /* the session has been closed by a request */
+  }
+  return UpdateTcpSocketEvents(socket, send_queue);
+}
+
+EipStatus HandleEncapsulationMessageOnTcpSocket(const int socket,
+                                                CipOctet *const message,
+                                                const size_t message_size) {
+  int remaining_bytes = 0;
+  OPENER_TRACE_INFO("Data received on TCP: %" PRIuSZT "\n", message_size);
+
+  g_current_active_tcp_socket = socket;
+
+  struct sockaddr sender_address;
+  memset( &sender_address, 0, sizeof(sender_address) );
+  socklen_t fromlen = sizeof(sender_address);
+  if(getpeername(socket, (struct sockaddr *) &sender_address, &fromlen) < 0) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR("networkhandler: could not get peername: %d - %s\n",
+                     error_code,
+                     error_message);
+    FreeErrorMessage(error_message);
+  }
+
+  ENIPMessage outgoing_message;
+  InitializeENIPMessage(&outgoing_message);
+  EipStatus need_to_send = HandleReceivedExplictTcpData(socket,
+                                                        message,
+                                                        message_size,
+                                                        &remaining_bytes,
+                                                        &sender_address,
+                                                        &outgoing_message);
+
+  g_current_active_tcp_socket = kEipInvalidSocket;
+
+  if(remaining_bytes != 0) {
+    OPENER_TRACE_WARN(
+      "Warning: received packet was to long: %d Bytes left!\n",
+      remaining_bytes);
+  }
+
+  if(need_to_send > 0) {
+    OPENER_TRACE_INFO("TCP reply: send %" PRIuSZT " bytes on %d\n",
+                      outgoing_message.used_message_length,
+                      socket);
+
+    SocketTimerSetLastUpdate(SocketTimerIndexGet(&s_socket_timer_index,
+                                                 socket),
+                             g_actual_time);
+    return SendOnTcpSocket(socket,
+                           outgoing_message.message_buffer,
+                           outgoing_message.used_message_length);
+  }
+  return kEipStatusOk;
 }
 
 /** @brief Create the UDP socket for the implicit IO messaging, one socket handles all connections
@@ -937,6 +1975,10 @@ int CreateUdpSocket(void) {
 
   OPENER_TRACE_INFO("networkhandler: UDP socket %d\n",
                     g_network_status.udp_io_messaging);
+  SetBusyPollOnIoSocket(g_network_status.udp_io_messaging);
+#if defined(OPENER_IO_TIMESTAMPING)
+  (void) IoTimestampingEnable(g_network_status.udp_io_messaging);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
 
   int option_value = 1;
   if (setsockopt( g_network_status.udp_io_messaging, SOL_SOCKET, SO_REUSEADDR,
@@ -946,6 +1988,16 @@ int CreateUdpSocket(void) {
     CloseUdpSocket(g_network_status.udp_io_messaging);
     return kEipInvalidSocket;
   }
+#if defined(OPENER_CONNECTED_UDP_SOCKETS) && defined(SO_REUSEPORT)
+  /* shares the port with the connected sockets */
+  if (setsockopt( g_network_status.udp_io_messaging, SOL_SOCKET, SO_REUSEPORT,
+                  (char *)&option_value, sizeof(option_value) ) < 0) {
+    OPENER_TRACE_ERR(
+      "error setting socket option SO_REUSEPORT on UDP socket\n");
+    CloseUdpSocket(g_network_status.udp_io_messaging);
+    return kEipInvalidSocket;
+  }
+#endif
 
   /* The bind on UDP sockets is necessary as the ENIP spec wants the source port to be specified to 2222 */
   struct sockaddr_in source_addr = {
@@ -966,17 +2018,162 @@ int CreateUdpSocket(void) {
     return kEipInvalidSocket;
   }
 
-  /* add new socket to the master list */
-  FD_SET(g_network_status.udp_io_messaging, &master_socket);
-
-  if (g_network_status.udp_io_messaging > highest_socket_handle) {
-    OPENER_TRACE_INFO("New highest socket: %d\n",
-                      g_network_status.udp_io_messaging);
-    highest_socket_handle = g_network_status.udp_io_messaging;
+#ifndef OPENER_IO_THREAD
+  /* add new socket to the watched sockets, the I/O thread watches the sockets
+   * once connections consume from them */
+  if (kEipStatusOk !=
+      NetworkEventAddSocket(g_network_status.udp_io_messaging,
+                            kNetworkEventReadable) ) {
+    CloseUdpSocket(g_network_status.udp_io_messaging);
+    return kEipInvalidSocket;
   }
+#endif
   return g_network_status.udp_io_messaging;
 }
 
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+int CreateConnectedUdpSocket(const struct sockaddr_in *const peer_address,
+                             const CipUsint qos_for_socket) {
+  int new_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (new_socket == kEipInvalidSocket) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR("networkhandler: cannot create UDP socket: %d- %s\n",
+                     error_code,
+                     error_message);
+    FreeErrorMessage(error_message);
+    return kEipInvalidSocket;
+  }
+
+  if (SetSocketToNonBlocking(new_socket) < 0) {
+    OPENER_TRACE_ERR(
+      "networkhandler: error setting connected UDP socket to non-blocking\n");
+    CloseUdpSocket(new_socket);
+    return kEipInvalidSocket;
+  }
+  SetBusyPollOnIoSocket(new_socket);
+#if defined(OPENER_IO_TIMESTAMPING)
+  (void) IoTimestampingEnable(new_socket);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+
+  /* all sockets of the IO messaging port are bound to the same address */
+  int option_value = 1;
+  if (setsockopt(new_socket, SOL_SOCKET, SO_REUSEADDR,
+                 (char *)&option_value, sizeof(option_value) ) < 0
+#if defined(SO_REUSEPORT)
+      || setsockopt(new_socket, SOL_SOCKET, SO_REUSEPORT,
+                    (char *)&option_value, sizeof(option_value) ) < 0
+#endif
+      ) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR(
+      "networkhandler: error setting the reuse options on connected UDP socket: %d - %s\n",
+      error_code,
+      error_message);
+    FreeErrorMessage(error_message);
+    CloseUdpSocket(new_socket);
+    return kEipInvalidSocket;
+  }
+
+  if (SetQosOnSocket( new_socket, CipQosGetDscpPriority(qos_for_socket) ) !=
+      0) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR("networkhandler: error on set QoS on socket: %d - %s\n",
+                     error_code, error_message);
+    FreeErrorMessage(error_message);
+    CloseUdpSocket(new_socket);
+    return kEipInvalidSocket;
+  }
+
+  struct sockaddr_in source_addr = {
+    .sin_family = AF_INET,
+    .sin_addr.s_addr = htonl(INADDR_ANY),
+    .sin_port = htons(kOpenerEipIoUdpPort)
+  };
+  if (bind(new_socket, (struct sockaddr *)&source_addr,
+           sizeof(source_addr) ) < 0 ||
+      connect(new_socket, (const struct sockaddr *)peer_address,
+              sizeof(*peer_address) ) < 0) {
+    int error_code = GetSocketErrorNumber();
+    char *error_message = GetErrorMessage(error_code);
+    OPENER_TRACE_ERR(
+      "networkhandler: error on bind or connect of connected UDP socket: %d - %s\n",
+      error_code,
+      error_message);
+    FreeErrorMessage(error_message);
+    CloseUdpSocket(new_socket);
+    return kEipInvalidSocket;
+  }
+
+  OPENER_TRACE_INFO("networkhandler: connected UDP socket %d\n", new_socket);
+
+#ifndef OPENER_IO_THREAD
+  if (kEipStatusOk != NetworkEventAddSocket(new_socket,
+                                            kNetworkEventReadable) ) {
+    CloseUdpSocket(new_socket);
+    return kEipInvalidSocket;
+  }
+#endif
+  return new_socket;
+}
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
+
+void AddConsumingUdpSocket(const int socket) {
+#ifdef OPENER_IO_THREAD
+  /* sized for all I/O connections of the connection capacity */
+  OPENER_ASSERT(s_number_of_consuming_sockets + 1 < s_io_thread_max_sockets);
+  s_consuming_sockets[s_number_of_consuming_sockets++] = socket;
+  s_io_thread_sockets_changed = true;
+#else
+  (void) socket; /* watched by the network events since its creation */
+#endif
+}
+
+void RemoveConsumingUdpSocket(const int socket) {
+#ifdef OPENER_IO_THREAD
+  for(size_t i = 0; i < s_number_of_consuming_sockets; i++) {
+    if(socket == s_consuming_sockets[i]) {
+      s_consuming_sockets[i] =
+        s_consuming_sockets[--s_number_of_consuming_sockets];
+      s_io_thread_sockets_changed = true;
+      return;
+    }
+  }
+#else
+  (void) socket;
+#endif
+}
+
+#if defined(OPENER_IO_SOCKET_FILTER)
+void UpdateIoSocketFilter(void) {
+  IoSocketFilterClear(&s_io_socket_filter);
+  for(const DoublyLinkedListNode *node = connection_list.first; NULL != node;
+      node = node->next) {
+    const CipConnectionObject *const connection_object = node->data;
+    if(kEipInvalidSocket !=
+       connection_object->socket[kUdpCommuncationDirectionConsuming]) {
+      IoSocketFilterAddConnection(&s_io_socket_filter,
+                                  connection_object->cip_consumed_connection_id,
+                                  connection_object->originator_address.sin_addr.s_addr);
+    }
+  }
+
+  /* only the sockets of the active connections are known to be open, all of
+   * them get the datagrams of any connection */
+  for(const DoublyLinkedListNode *node = connection_list.first; NULL != node;
+      node = node->next) {
+    const CipConnectionObject *const connection_object = node->data;
+    const int consuming_socket =
+      connection_object->socket[kUdpCommuncationDirectionConsuming];
+    if(kEipInvalidSocket != consuming_socket) {
+      (void) IoSocketFilterAttach(&s_io_socket_filter, consuming_socket);
+    }
+  }
+}
+#endif /* defined(OPENER_IO_SOCKET_FILTER) */
+
 /** @brief Set the Qos the socket for implicit IO messaging
  *
  * @return 0 if successful, else the error code */
@@ -1048,74 +2245,172 @@ EipUint32 GetPeerAddress(void) {
 }
 
 void CheckAndHandleConsumingUdpSocket(void) {
-  DoublyLinkedListNode *iterator = connection_list.first;
-
-  CipConnectionObject *current_connection_object = NULL;
-
-  /* see a message of the registered UDP socket has been received     */
-  while(NULL != iterator) {
-    current_connection_object = (CipConnectionObject *) iterator->data;
-    iterator = iterator->next; /* do this at the beginning as the close function may can make the entry invalid */
-
-    if( (kEipInvalidSocket !=
-         current_connection_object->socket[kUdpCommuncationDirectionConsuming])
-        && ( true ==
-             CheckSocketSet(current_connection_object->socket[
-                              kUdpCommuncationDirectionConsuming
-                            ]) ) ) {
-      OPENER_TRACE_INFO("Processing UDP consuming message\n");
-      struct sockaddr_in from_address = { 0 };
-      socklen_t from_address_length = sizeof(from_address);
-      CipOctet incoming_message[PC_OPENER_ETHERNET_BUFFER_SIZE] = { 0 };
-
-      int received_size = recvfrom(g_network_status.udp_io_messaging,
-                                   NWBUF_CAST incoming_message,
-                                   sizeof(incoming_message),
-                                   0,
-                                   (struct sockaddr *) &from_address,
-                                   &from_address_length);
-      if(0 == received_size) {
-        int error_code = GetSocketErrorNumber();
-        char *error_message = GetErrorMessage(error_code);
-        OPENER_TRACE_ERR(
-          "networkhandler: socket: %d - connection closed by client: %d - %s\n",
-          current_connection_object->socket[
-            kUdpCommuncationDirectionConsuming],
-          error_code,
-          error_message);
-        FreeErrorMessage(error_message);
-        current_connection_object->connection_close_function(
-          current_connection_object);
+  /* a socket closed while handling an earlier one is not reported anymore */
+  for(int i = 0; i < ready_event_count; i++) {
+    const int socket = ready_events[i].socket;
+    if( (ready_events[i].events & kNetworkEventReadable) &&
+        NULL != GetConnectionConsumingFromSocket(socket) ) {
+      ready_events[i].events &= ~(unsigned int) kNetworkEventReadable;
+      HandleConsumingUdpSocket(socket);
+    }
+  }
+}
+
+static void HandleConsumingUdpSocket(const int socket) {
+  if(NULL == GetConnectionConsumingFromSocket(socket) ) {
+    return;
+  }
+  OPENER_TRACE_INFO("Processing UDP consuming message\n");
+  if(kEipStatusOk != ReceiveConnectedDataOnUdpSocket(socket) ) {
+    /* the connections handling the received data may have been closed */
+    CipConnectionObject *const connection_object =
+      GetConnectionConsumingFromSocket(socket);
+    if(NULL != connection_object) {
+      connection_object->connection_close_function(connection_object);
+    }
+  }
+}
+
+EipStatus ReceiveConnectedDataOnUdpSocket(const int socket) {
+#if defined(OPENER_HAVE_RECVMMSG)
+  static CipOctet incoming_messages[OPENER_UDP_RECEIVE_BATCH_SIZE][
+    PC_OPENER_ETHERNET_BUFFER_SIZE];
+  static struct sockaddr_in from_addresses[OPENER_UDP_RECEIVE_BATCH_SIZE];
+#if defined(OPENER_IO_TIMESTAMPING)
+  static char controls[OPENER_UDP_RECEIVE_BATCH_SIZE][
+    IO_TIMESTAMPING_CONTROL_SIZE];
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+  struct iovec io_vectors[OPENER_UDP_RECEIVE_BATCH_SIZE];
+  struct mmsghdr messages[OPENER_UDP_RECEIVE_BATCH_SIZE];
+
+  memset( messages, 0, sizeof(messages) );
+  for(size_t i = 0; i < OPENER_UDP_RECEIVE_BATCH_SIZE; i++) {
+    io_vectors[i].iov_base = incoming_messages[i];
+    io_vectors[i].iov_len = sizeof(incoming_messages[i]);
+    messages[i].msg_hdr.msg_iov = &io_vectors[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_name = &from_addresses[i];
+  }
+
+  for(size_t batch = 0; batch < OPENER_UDP_RECEIVE_BATCHES_PER_WAKEUP;
+      batch++) {
+    /* the datagrams are handled in place, only the address length is
+     * overwritten by the previous batch */
+    for(size_t i = 0; i < OPENER_UDP_RECEIVE_BATCH_SIZE; i++) {
+      messages[i].msg_hdr.msg_namelen = sizeof(from_addresses[i]);
+#if defined(OPENER_IO_TIMESTAMPING)
+      messages[i].msg_hdr.msg_control = controls[i];
+      messages[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+    }
+
+    int number_of_messages = recvmmsg(socket,
+                                      messages,
+                                      OPENER_UDP_RECEIVE_BATCH_SIZE,
+                                      0,
+                                      NULL);
+    if(0 > number_of_messages) {
+      int error_code = GetSocketErrorNumber();
+      if(OPENER_SOCKET_WOULD_BLOCK == error_code) {
+        return kEipStatusOk; // No fatal error, resume execution
+      }
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+      if(ECONNREFUSED == error_code) {
+        /* a connected socket reports an ICMP port unreachable of the peer,
+         * the watchdog of the connection decides on closing it */
         continue;
       }
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
+      char *error_message = GetErrorMessage(error_code);
+      OPENER_TRACE_ERR("networkhandler: error on recvmmsg: %d - %s\n",
+                       error_code,
+                       error_message);
+      FreeErrorMessage(error_message);
+      return kEipStatusError;
+    }
 
-      if(0 > received_size) {
-        int error_code = GetSocketErrorNumber();
-        if(OPENER_SOCKET_WOULD_BLOCK == error_code) {
-          return; // No fatal error, resume execution
-        } 
-        char *error_message = GetErrorMessage(error_code);
-        OPENER_TRACE_ERR("networkhandler: error on recv: %d - %s\n",
-                           error_code,
-                           error_message);
-        FreeErrorMessage(error_message);
-        current_connection_object->connection_close_function(
-          current_connection_object);
+    for(int i = 0; i < number_of_messages; i++) {
+      if(0 < messages[i].msg_len) {
+#if defined(OPENER_IO_TIMESTAMPING)
+        SetConnectedDataReceiveTime(IoTimestampingGetReceiveTime(
+                                      &messages[i].msg_hdr) );
+#endif /* defined(OPENER_IO_TIMESTAMPING) */
+        HandleReceivedConnectedData(incoming_messages[i],
+                                    (int) messages[i].msg_len,
+                                    &from_addresses[i]);
+      }
+    }
+
+    if(OPENER_UDP_RECEIVE_BATCH_SIZE > number_of_messages) {
+      return kEipStatusOk; /* the socket is drained */
+    }
+  }
+  return kEipStatusOk;
+#else
+  /* without recvmmsg() the datagrams of the batches are received one by one */
+  for(size_t i = 0;
+      i < OPENER_UDP_RECEIVE_BATCHES_PER_WAKEUP * OPENER_UDP_RECEIVE_BATCH_SIZE;
+      i++) {
+    struct sockaddr_in from_address = { 0 };
+    socklen_t from_address_length = sizeof(from_address);
+    CipOctet incoming_message[PC_OPENER_ETHERNET_BUFFER_SIZE];
+
+    int received_size = recvfrom(socket,
+                                 NWBUF_CAST incoming_message,
+                                 sizeof(incoming_message),
+                                 0,
+                                 (struct sockaddr *) &from_address,
+                                 &from_address_length);
+    if(0 > received_size) {
+      int error_code = GetSocketErrorNumber();
+      if(OPENER_SOCKET_WOULD_BLOCK == error_code) {
+        return kEipStatusOk; // No fatal error, resume execution
+      }
+#if defined(OPENER_CONNECTED_UDP_SOCKETS)
+      if(ECONNREFUSED == error_code) {
+        /* a connected socket reports an ICMP port unreachable of the peer,
+         * the watchdog of the connection decides on closing it */
         continue;
       }
+#endif /* defined(OPENER_CONNECTED_UDP_SOCKETS) */
+      char *error_message = GetErrorMessage(error_code);
+      OPENER_TRACE_ERR("networkhandler: error on recv: %d - %s\n",
+                       error_code,
+                       error_message);
+      FreeErrorMessage(error_message);
+      return kEipStatusError;
+    }
 
+    if(0 < received_size) {
       HandleReceivedConnectedData(incoming_message, received_size,
                                   &from_address);
-
     }
   }
+  return kEipStatusOk;
+#endif /* defined(OPENER_HAVE_RECVMMSG) */
 }
 
 void CloseSocket(const int socket_handle) {
   OPENER_TRACE_INFO("networkhandler: closing socket %d\n", socket_handle);
 
   if(kEipInvalidSocket != socket_handle) {
-    FD_CLR(socket_handle, &master_socket);
+    NetworkEventRemoveSocket(socket_handle);
+    /* a closed socket handle may be reused by a later accept in this cycle */
+    for(int i = 0; i < ready_event_count; i++) {
+      if(socket_handle == ready_events[i].socket &&
+         kNetworkEventNone != ready_events[i].events) {
+        OPENER_TRACE_INFO("socket: %d closed with pending message\n",
+                          socket_handle);
+        ready_events[i].events = kNetworkEventNone;
+      }
+    }
+#ifdef OPENER_IO_THREAD
+    for(nfds_t i = 1; i < s_io_thread_socket_count; i++) {
+      if(socket_handle == s_io_thread_sockets[i].fd) {
+        s_io_thread_sockets[i].revents = 0;
+      }
+    }
+#endif
     CloseSocketPlatform(socket_handle);
   } OPENER_TRACE_INFO("networkhandler: closing socket done %d\n",
                       socket_handle);
@@ -1140,31 +2435,48 @@ int GetMaxSocket(int socket1,
   return socket4;
 }
 
-void CheckEncapsulationInactivity(int socket_handle) {
-  if(0 < g_tcpip.encapsulation_inactivity_timeout) { //*< Encapsulation inactivity timeout is enabled
-    SocketTimer *socket_timer = SocketTimerArrayGetSocketTimer(g_timestamps,
-                                                               OPENER_NUMBER_OF_SUPPORTED_SESSIONS,
-                                                               socket_handle);
-
-//    OPENER_TRACE_INFO("Check socket %d - socket timer: %p\n",
-//                      socket_handle,
-//                      socket_timer);
-    if(NULL != socket_timer) {
-      MilliSeconds diff_milliseconds = g_actual_time - SocketTimerGetLastUpdate(
-        socket_timer);
+void CheckEncapsulationInactivity(void) {
+  const MicroSeconds current_time = GetMicroSeconds();
+  if(s_inactivity_timeout != g_tcpip.encapsulation_inactivity_timeout) {
+    /* the timeout has been changed, check all sessions against the new one */
+    s_inactivity_timeout = g_tcpip.encapsulation_inactivity_timeout;
+    for(size_t i = 0; i < OPENER_NUMBER_OF_SUPPORTED_SESSIONS; i++) {
+      if(kEipInvalidSocket == g_timestamps[i].socket) {
+        continue;
+      }
+      if(0 < s_inactivity_timeout) { //*< Encapsulation inactivity timeout is enabled
+        ScheduleInactivityTimer(&g_timestamps[i], current_time, 0);
+      } else {
+        DeadlineQueueCancel(&s_inactivity_timers,
+                            &g_timestamps[i].inactivity_timer);
+      }
+    }
+  }
 
-      if( diff_milliseconds >=
-          (MilliSeconds) (1000UL * g_tcpip.encapsulation_inactivity_timeout) ) {
+  /* activity only updates the socket timer, the queued timer is moved to the
+   * new expiry when it is checked */
+  const MilliSeconds timeout = 1000UL * s_inactivity_timeout;
+  DeadlineQueueEntry *timer = NULL;
+  while( NULL != ( timer = DeadlineQueuePopExpired(&s_inactivity_timers,
+                                                   current_time) ) ) {
+    SocketTimer *const socket_timer = timer->data;
+    const MilliSeconds diff_milliseconds = g_actual_time -
+                                           SocketTimerGetLastUpdate(
+      socket_timer);
+    if(diff_milliseconds < timeout) {
+      ScheduleInactivityTimer(socket_timer, current_time,
+                              timeout - diff_milliseconds);
+      continue;
+    }
 
-        CipSessionHandle encapsulation_session_handle =
-          GetSessionFromSocket(socket_handle);
+    const int socket_handle = socket_timer->socket;
+    CipSessionHandle encapsulation_session_handle =
+      GetSessionFromSocket(socket_handle);
 
-        CloseClass3ConnectionBasedOnSession(encapsulation_session_handle);
+    CloseClass3ConnectionBasedOnSession(encapsulation_session_handle);
 
-        CloseTcpSocket(socket_handle);
-        RemoveSession(socket_handle);
-      }
-    }
+    CloseTcpSocket(socket_handle);
+    RemoveSession(socket_handle);
   }
 }
 
@@ -30,12 +30,42 @@
 #include "networkhandler.h"
 #include "appcontype.h"
 #include "socket_timer.h"
+#include "network_event.h"
+#include "tcp_receive_buffer.h"
+#include "tcp_send_queue.h"
+
+/** @brief Maximum number of TCP connections open at the same time
+ *
+ *  Further connection requests are accepted and closed right away. Can be set
+ *  lower than OPENER_NUMBER_OF_SUPPORTED_SESSIONS to keep resources for the
+ *  sessions being closed.
+ */
+#ifndef OPENER_TCP_CONNECTION_LIMIT
+  #define OPENER_TCP_CONNECTION_LIMIT OPENER_NUMBER_OF_SUPPORTED_SESSIONS
+#endif
+
+#if OPENER_TCP_CONNECTION_LIMIT > OPENER_NUMBER_OF_SUPPORTED_SESSIONS
+  #error "OPENER_TCP_CONNECTION_LIMIT exceeds OPENER_NUMBER_OF_SUPPORTED_SESSIONS"
+#endif
+
+/** @brief Time in microseconds explicit messaging may take per cycle
+ *
+ *  Consumed I/O data and due productions are handled before any explicit
+ *  message. Explicit requests are then handled until the budget is used up,
+ *  the sessions not served are handled first in the next cycle. The budget
+ *  can be changed at run time in g_network_status, 0 means no limit.
+ */
+#ifndef OPENER_EXPLICIT_MESSAGING_TIME_BUDGET_US
+  #define OPENER_EXPLICIT_MESSAGING_TIME_BUDGET_US 1000
+#endif
 
 /*The port to be used per default for I/O messages on UDP.*/
 extern const uint16_t kOpenerEipIoUdpPort;
 extern const uint16_t kOpenerEthernetPort;
 
 extern SocketTimer g_timestamps[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+extern TcpReceiveBuffer g_tcp_receive_buffers[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
+extern TcpSendQueue g_tcp_send_queues[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
 /** @brief Ethernet/IP standard ports */
 #define kOpenerEthernetPort   44818     /** Port to be used per default for messages on TCP */
 #define kOpenerEipIoUdpPort   2222      /** Port to be used per default for I/O messages on UDP.*/
@@ -43,6 +73,7 @@ extern SocketTimer g_timestamps[OPENER_NUMBER_OF_SUPPORTED_SESSIONS];
 
 //EipUint8 g_ethernet_communication_buffer[PC_OPENER_ETHERNET_BUFFER_SIZE]; /**< communication buffer */
 
+/* Only available with the select() based network event backend */
 extern fd_set master_socket;
 extern fd_set read_socket;
 
@@ -68,6 +99,17 @@ typedef struct {
   CipUdint ip_address; /**< IP being valid during NetworkHandlerInitialize() */
   CipUdint network_mask; /**< network mask being valid during NetworkHandlerInitialize() */
   MilliSeconds elapsed_time;
+  size_t tcp_connection_count; /**< number of open TCP connections */
+  CipUdint accepted_tcp_connections; /**< TCP connections accepted since start up */
+  CipUdint rejected_tcp_connections; /**< TCP connections closed right after accept due to the connection limit or missing resources */
+  MicroSeconds explicit_time_budget; /**< time explicit messaging may take per cycle, 0 for no limit */
+  CipUdint deferred_explicit_sessions; /**< sessions with pending requests deferred to the next cycle by the time budget */
+  CipUdint explicit_budget_overruns; /**< cycles in which explicit messaging took longer than the time budget */
+  MicroSeconds busy_poll_time; /**< busy poll time set on the I/O sockets, 0 for no busy polling, set before NetworkHandlerInitialize() */
+  bool spin_wait; /**< poll the I/O sockets without sleeping, set before NetworkHandlerInitialize() */
+  CipUdint wake_up_count; /**< wake ups for a connection timer or tick measured */
+  MicroSeconds wake_up_latency_sum; /**< sum of the measured wake up latencies */
+  MicroSeconds wake_up_latency_max; /**< largest measured wake up latency */
 } NetworkStatus;
 
 extern NetworkStatus g_network_status; /**< Global variable holding the current network status */
@@ -82,11 +124,42 @@ void CloseUdpSocket(int socket_handle);
 
 void CloseTcpSocket(int socket_handle);
 
+/** @brief Starts the encapsulation inactivity supervision of a TCP socket
+ *
+ *  The socket timer of an already supervised socket is updated.
+ *
+ *  @param socket_handle The socket of the registered session
+ */
+void AddSocketTimerToList(const int socket_handle);
+
+/** @brief Stops the encapsulation inactivity supervision of a TCP socket
+ *
+ *  @param socket_handle The socket of the session
+ */
+void RemoveSocketTimerFromList(const int socket_handle);
+
 EipStatus NetworkHandlerProcessCyclic(void);
 
+#ifdef OPENER_IO_THREAD
+/** @brief One cycle of the I/O thread
+ *
+ *  Receives the data of the consuming sockets and handles the connection
+ *  timers, while NetworkHandlerProcessCyclic() handles the explicit messaging
+ *  on another thread. Both serialize their access to the stack by a lock held
+ *  only while processing, never while waiting.
+ *
+ *  @return kEipStatusOk on success, kEipStatusError on a fatal error
+ */
+EipStatus NetworkHandlerProcessImplicit(void);
+#endif /* OPENER_IO_THREAD */
+
 EipStatus NetworkHandlerFinish(void);
 
-/** @brief check if the given socket is set in the read set
+/** @brief check if the given socket has been reported readable in the current
+ * cycle and was not handled yet
+ *
+ * The socket is removed from the ready sockets, so that later checks will not
+ * find it again.
  * @param socket The socket to check
  * @return true if socket is set
  */
@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file network_event.h
+ *  @brief Socket readiness notification backend of the network handler
+ *
+ *  The generic network handler registers every socket it wants to be woken
+ *  up for and afterwards only gets the ready sockets reported by
+ *  NetworkEventWait(). The select() based backend is the portable default, a
+ *  port may provide a more scalable backend (e.g., epoll on POSIX) which is
+ *  chosen at build time.
+ */
+
+#ifndef SRC_PORTS_NETWORK_EVENT_H_
+#define SRC_PORTS_NETWORK_EVENT_H_
+
+#include "typedefs.h"
+#include "opener_user_conf.h"
+
+/** @brief Maximum number of ready sockets reported by one NetworkEventWait()
+ *
+ *  Sockets which are ready but did not fit are reported by the next call, as
+ *  all backends are level-triggered.
+ */
+#ifndef OPENER_NETWORK_EVENT_MAX_EVENTS
+  #define OPENER_NETWORK_EVENT_MAX_EVENTS (OPENER_NUMBER_OF_SUPPORTED_SESSIONS + \
+                                           8)
+#endif
+
+/** @brief Readiness conditions a socket can be registered for, used as bit
+ *  flags
+ */
+typedef enum {
+  kNetworkEventNone = 0, /**< No event */
+  kNetworkEventReadable = 1, /**< Data can be read or the peer closed */
+  kNetworkEventWritable = 2 /**< Data can be written without blocking */
+} NetworkEventType;
+
+/** @brief A ready socket together with its pending events */
+typedef struct {
+  int socket; /**< the ready socket */
+  unsigned int events; /**< pending events, see NetworkEventType */
+} NetworkEvent;
+
+/** @brief Set up the readiness backend
+ *
+ *  @return kEipStatusOk on success, otherwise kEipStatusError
+ */
+EipStatus NetworkEventInitialize(void);
+
+/** @brief Release all resources of the readiness backend */
+void NetworkEventFinish(void);
+
+/** @brief Start watching a socket
+ *
+ *  @param socket The socket to be watched
+ *  @param events The events the socket is watched for, see NetworkEventType
+ *  @return kEipStatusOk on success, otherwise kEipStatusError
+ */
+EipStatus NetworkEventAddSocket(const int socket,
+                                const unsigned int events);
+
+/** @brief Change the events a watched socket is watched for
+ *
+ *  @param socket The watched socket
+ *  @param events The events the socket is watched for, see NetworkEventType
+ *  @return kEipStatusOk on success, otherwise kEipStatusError
+ */
+EipStatus NetworkEventModifySocket(const int socket,
+                                   const unsigned int events);
+
+/** @brief Stop watching a socket, has to be called before the socket is closed
+ *
+ *  @param socket The socket to be removed
+ */
+void NetworkEventRemoveSocket(const int socket);
+
+/** @brief Wait until at least one watched socket is ready or the timeout
+ *  expired
+ *
+ *  @param timeout Maximum time to wait in microseconds
+ *  @param events Array receiving the ready sockets
+ *  @param max_events Length of the events array
+ *  @return Number of ready sockets, 0 on timeout, -1 on error (errno is set)
+ */
+int NetworkEventWait(const MicroSeconds timeout,
+                     NetworkEvent *const events,
+                     const size_t max_events);
+
+#endif /* SRC_PORTS_NETWORK_EVENT_H_ */
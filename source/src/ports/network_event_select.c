@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+/** @file network_event_select.c
+ *  @brief select() based readiness backend, the portable default used by all
+ *  ports which do not provide a dedicated backend
+ */
+
+#include "network_event.h"
+
+#include "generic_networkhandler.h"
+#include "trace.h"
+
+fd_set master_socket;
+fd_set read_socket;
+
+int highest_socket_handle;
+
+/** @brief Sockets watched for writability */
+static fd_set s_master_write_socket;
+
+/** @brief Working copy of s_master_write_socket for select() */
+static fd_set s_write_socket;
+
+struct timeval g_time_value;
+
+EipStatus NetworkEventInitialize(void) {
+  /* clear the master and temp sets */
+  FD_ZERO(&master_socket);
+  FD_ZERO(&read_socket);
+  FD_ZERO(&s_master_write_socket);
+  FD_ZERO(&s_write_socket);
+  highest_socket_handle = 0;
+  return kEipStatusOk;
+}
+
+void NetworkEventFinish(void) {
+  FD_ZERO(&master_socket);
+  FD_ZERO(&read_socket);
+  FD_ZERO(&s_master_write_socket);
+  FD_ZERO(&s_write_socket);
+}
+
+EipStatus NetworkEventAddSocket(const int socket,
+                                const unsigned int events) {
+  /* keep track of the biggest file descriptor */
+  if(socket > highest_socket_handle) {
+    OPENER_TRACE_INFO("New highest socket: %d\n", socket);
+    highest_socket_handle = socket;
+  }
+  return NetworkEventModifySocket(socket, events);
+}
+
+EipStatus NetworkEventModifySocket(const int socket,
+                                   const unsigned int events) {
+  if(events & kNetworkEventReadable) {
+    FD_SET(socket, &master_socket);
+  } else {
+    FD_CLR(socket, &master_socket);
+  }
+  if(events & kNetworkEventWritable) {
+    FD_SET(socket, &s_master_write_socket);
+  } else {
+    FD_CLR(socket, &s_master_write_socket);
+  }
+  return kEipStatusOk;
+}
+
+void NetworkEventRemoveSocket(const int socket) {
+  FD_CLR(socket, &master_socket);
+  FD_CLR(socket, &s_master_write_socket);
+}
+
+int NetworkEventWait(const MicroSeconds timeout,
+                     NetworkEvent *const events,
+                     const size_t max_events) {
+  read_socket = master_socket;
+  s_write_socket = s_master_write_socket;
+
+  g_time_value.tv_sec = (long) (timeout / 1000000ULL);
+  g_time_value.tv_usec = (long) (timeout % 1000000ULL);
+
+  int ready_socket = select(highest_socket_handle + 1,
+                            &read_socket,
+                            &s_write_socket,
+                            0,
+                            &g_time_value);
+  if(ready_socket <= 0) {
+    return ready_socket;
+  }
+
+  size_t number_of_events = 0;
+  for(int socket = 0;
+      socket <= highest_socket_handle && number_of_events < max_events;
+      socket++) {
+    unsigned int socket_events = kNetworkEventNone;
+    if( FD_ISSET(socket, &read_socket) ) {
+      socket_events |= kNetworkEventReadable;
+    }
+    if( FD_ISSET(socket, &s_write_socket) ) {
+      socket_events |= kNetworkEventWritable;
+    }
+    if(kNetworkEventNone != socket_events) {
+      events[number_of_events].socket = socket;
+      events[number_of_events].events = socket_events;
+      number_of_events++;
+    }
+  }
+  return (int) number_of_events;
+}
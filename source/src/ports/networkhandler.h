@@ -71,4 +71,17 @@ MilliSeconds GetMilliSeconds(void);
 int SetQosOnSocket(const int socket,
                    CipUsint qos_value);
 
+/** @brief Lets the kernel busy poll the device queue for a socket
+ *
+ * A platform dependent implementation, platforms without busy polling do
+ * nothing and return 0.
+ *
+ * @param socket The socket to be busy polled
+ * @param busy_poll_time Time to busy poll for received data in microseconds
+ *
+ * @return platform dependent result code
+ */
+int SetBusyPollOnSocket(const int socket,
+                        const MicroSeconds busy_poll_time);
+
 #endif /* OPENER_NETWORKHANDLER_H_ */
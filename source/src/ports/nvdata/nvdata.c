@@ -20,6 +20,12 @@
 #include "nvqos.h"
 #include "nvtcpip.h"
 
+#ifdef OPENER_IO_THREAD
+/* NV data changed by a request, written later by NvdataStorePending() */
+static bool s_qos_store_pending = false;
+static bool s_tcpip_store_pending = false;
+#endif /* OPENER_IO_THREAD */
+
 /** @brief Load NV data for all object classes
  *
  *  @return kEipStatusOk on success, kEipStatusError if failure for any object occurred
@@ -77,7 +83,11 @@ EipStatus NvQosSetCallback(CipInstance *const instance,
                       instance->cip_class->class_name,
                       instance->instance_number,
                       attribute->attribute_number);
+#ifdef OPENER_IO_THREAD
+    s_qos_store_pending = true;
+#else
     status = NvQosStore(&g_qos);
+#endif
   }
   return status;
 }
@@ -112,8 +122,40 @@ EipStatus NvTcpipSetCallback(CipInstance *const instance,
                         instance->cip_class->class_name,
                         instance->instance_number,
                         attribute->attribute_number);
+#ifdef OPENER_IO_THREAD
+      s_tcpip_store_pending = true;
+#else
       status = NvTcpipStore(&g_tcpip);
+#endif
+    }
+  }
+  return status;
+}
+
+#ifdef OPENER_IO_THREAD
+/** @brief Store the NV data changed since the last call
+ *
+ *  @return kEipStatusOk on success, kEipStatusError if failure for any object occurred
+ *
+ * With the I/O thread the set callbacks only mark the NV data as changed,
+ *  as they are called while the I/O thread is locked out of the stack. The
+ *  application calls this function after NetworkHandlerProcessCyclic(), so
+ *  that slow writes to the external storage do not delay the I/O.
+ */
+EipStatus NvdataStorePending(void) {
+  EipStatus status = kEipStatusOk;
+  if (s_qos_store_pending) {
+    s_qos_store_pending = false;
+    if (kEipStatusError == NvQosStore(&g_qos) ) {
+      status = kEipStatusError;
+    }
+  }
+  if (s_tcpip_store_pending) {
+    s_tcpip_store_pending = false;
+    if (kEipStatusError == NvTcpipStore(&g_tcpip) ) {
+      status = kEipStatusError;
     }
   }
   return status;
 }
+#endif /* OPENER_IO_THREAD */
@@ -31,4 +31,8 @@ EipStatus NvTcpipSetCallback
     CipByte service
 );
 
+#ifdef OPENER_IO_THREAD
+EipStatus NvdataStorePending(void);
+#endif
+
 #endif  /* ifndef NVDATA_H_ */
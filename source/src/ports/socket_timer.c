@@ -35,6 +35,8 @@ void SocketTimerArrayInitialize(SocketTimer *const array_of_socket_timers,
                                 const size_t array_length) {
   for (size_t i = 0; i < array_length; ++i) {
     SocketTimerClear(&array_of_socket_timers[i]);
+    DeadlineQueueEntryInitialize(&array_of_socket_timers[i].inactivity_timer,
+                                 &array_of_socket_timers[i]);
   }
 }
 
@@ -56,3 +58,84 @@ SocketTimer *SocketTimerArrayGetEmptySocketTimer(
   return SocketTimerArrayGetSocketTimer(array_of_socket_timers, array_length,
                                         kEipInvalidSocket);
 }
+
+/** @brief Home slot of a socket in the index */
+static size_t SocketTimerIndexGetHomeSlot(const SocketTimerIndex *const index,
+                                          const int socket) {
+  /* Fibonacci hashing spreads the consecutive socket handles */
+  return (size_t) ( (uint32_t) socket * UINT32_C(2654435769) ) % index->size;
+}
+
+void SocketTimerIndexInitialize(SocketTimerIndex *const index,
+                                SocketTimer **const storage,
+                                const size_t size) {
+  index->slots = storage;
+  index->size = size;
+  for (size_t i = 0; i < size; ++i) {
+    index->slots[i] = NULL;
+  }
+}
+
+bool SocketTimerIndexAdd(SocketTimerIndex *const index,
+                         SocketTimer *const socket_timer) {
+  size_t slot = SocketTimerIndexGetHomeSlot(index, socket_timer->socket);
+  for (size_t i = 0; i < index->size; ++i) {
+    if (NULL == index->slots[slot] ||
+        socket_timer->socket == index->slots[slot]->socket) {
+      index->slots[slot] = socket_timer;
+      return true;
+    }
+    slot = (slot + 1) % index->size;
+  }
+  return false;
+}
+
+SocketTimer *SocketTimerIndexGet(const SocketTimerIndex *const index,
+                                 const int socket) {
+  size_t slot = SocketTimerIndexGetHomeSlot(index, socket);
+  for (size_t i = 0; i < index->size && NULL != index->slots[slot]; ++i) {
+    if (socket == index->slots[slot]->socket) {
+      return index->slots[slot];
+    }
+    slot = (slot + 1) % index->size;
+  }
+  return NULL;
+}
+
+SocketTimer *SocketTimerIndexRemove(SocketTimerIndex *const index,
+                                    const int socket) {
+  size_t slot = SocketTimerIndexGetHomeSlot(index, socket);
+  size_t i = 0;
+  while (i < index->size && NULL != index->slots[slot] &&
+         socket != index->slots[slot]->socket) {
+    slot = (slot + 1) % index->size;
+    ++i;
+  }
+  if (i == index->size || NULL == index->slots[slot]) {
+    return NULL;
+  }
+  SocketTimer *const removed_timer = index->slots[slot];
+  index->slots[slot] = NULL;
+
+  /* move the following entries of the probe sequence into the gap, which
+   * keeps the index free of deletion markers */
+  size_t gap = slot;
+  slot = (slot + 1) % index->size;
+  while (NULL != index->slots[slot]) {
+    const size_t home_slot = SocketTimerIndexGetHomeSlot(index,
+                                                         index->slots[slot]->
+                                                         socket);
+    /* the entry may fill the gap if its home slot is not between the gap
+     * and its current slot, cyclically */
+    const size_t distance_to_home = (slot + index->size - home_slot) %
+                                    index->size;
+    const size_t distance_to_gap = (slot + index->size - gap) % index->size;
+    if (distance_to_gap <= distance_to_home) {
+      index->slots[gap] = index->slots[slot];
+      index->slots[slot] = NULL;
+      gap = slot;
+    }
+    slot = (slot + 1) % index->size;
+  }
+  return removed_timer;
+}
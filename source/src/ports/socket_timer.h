@@ -8,6 +8,7 @@
 #define SRC_PORTS_SOCKET_TIMER_H_
 
 #include "typedefs.h"
+#include "deadlinequeue.h"
 
 /** @brief Data structure to store last usage times for sockets
  *
@@ -15,8 +16,19 @@
 typedef struct socket_timer {
   int socket;       /**< key */
   MilliSeconds last_update;       /**< time stop of last update */
+  DeadlineQueueEntry inactivity_timer; /**< next check of the inactivity timeout */
 } SocketTimer;
 
+/** @brief Hash index of the used Socket Timers by their socket
+ *
+ * Open addressing with linear probing, the storage is provided by the user and
+ * should have about twice as many slots as there are Socket Timers.
+ */
+typedef struct {
+  SocketTimer **slots; /**< the indexed timers, NULL for free slots */
+  size_t size; /**< number of slots */
+} SocketTimerIndex;
+
 
 /** @brief
  * Sets socket of a Socket Timer
@@ -86,4 +98,48 @@ SocketTimer *SocketTimerArrayGetEmptySocketTimer(
   SocketTimer *const array_of_socket_timers,
   const size_t array_length);
 
+/** @brief
+ * Initializes an empty Socket Timer index
+ *
+ * @param index The index to be initialized
+ * @param storage The slots of the index
+ * @param size The number of slots
+ */
+void SocketTimerIndexInitialize(SocketTimerIndex *const index,
+                                SocketTimer **const storage,
+                                const size_t size);
+
+/** @brief
+ * Adds a Socket Timer with its current socket to the index
+ *
+ * @param index The index
+ * @param socket_timer The Socket Timer to be added
+ *
+ * @return false if the index is full
+ */
+bool SocketTimerIndexAdd(SocketTimerIndex *const index,
+                         SocketTimer *const socket_timer);
+
+/** @brief
+ * Get the Socket Timer of a socket from the index
+ *
+ * @param index The index
+ * @param socket The socket value to be searched for
+ *
+ * @return The Socket Timer if found, otherwise NULL
+ */
+SocketTimer *SocketTimerIndexGet(const SocketTimerIndex *const index,
+                                 const int socket);
+
+/** @brief
+ * Removes the Socket Timer of a socket from the index
+ *
+ * @param index The index
+ * @param socket The socket of the Socket Timer to be removed
+ *
+ * @return The removed Socket Timer, NULL if none was indexed for the socket
+ */
+SocketTimer *SocketTimerIndexRemove(SocketTimerIndex *const index,
+                                    const int socket);
+
 #endif /* SRC_PORTS_SOCKET_TIMER_H_ */
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+
+#include "tcp_receive_buffer.h"
+
+#include "encap.h"
+#include "endianconv.h"
+#include "trace.h"
+
+void TcpReceiveBufferClear(TcpReceiveBuffer *const receive_buffer) {
+  receive_buffer->socket = kEipInvalidSocket;
+  receive_buffer->start = 0;
+  receive_buffer->length = 0;
+  receive_buffer->bytes_to_discard = 0;
+}
+
+void TcpReceiveBufferSetSocket(TcpReceiveBuffer *const receive_buffer,
+                               const int socket) {
+  TcpReceiveBufferClear(receive_buffer);
+  receive_buffer->socket = socket;
+}
+
+CipOctet *TcpReceiveBufferGetWritePosition(
+  TcpReceiveBuffer *const receive_buffer,
+  size_t *const free_space) {
+  if(0 == receive_buffer->length) {
+    receive_buffer->start = 0;
+  } else if(OPENER_TCP_RECEIVE_BUFFER_SIZE ==
+            receive_buffer->start + receive_buffer->length) {
+    /* end reached, move the incomplete message to the front */
+    memmove(receive_buffer->data,
+            &receive_buffer->data[receive_buffer->start],
+            receive_buffer->length);
+    receive_buffer->start = 0;
+  }
+  size_t end = receive_buffer->start + receive_buffer->length;
+  *free_space = OPENER_TCP_RECEIVE_BUFFER_SIZE - end;
+  return &receive_buffer->data[end];
+}
+
+void TcpReceiveBufferCommit(TcpReceiveBuffer *const receive_buffer,
+                            const size_t number_of_bytes) {
+  OPENER_ASSERT(receive_buffer->start + receive_buffer->length +
+                number_of_bytes <= OPENER_TCP_RECEIVE_BUFFER_SIZE);
+  receive_buffer->length += number_of_bytes;
+}
+
+bool TcpReceiveBufferHasMessage(const TcpReceiveBuffer *const receive_buffer) {
+  if(0 < receive_buffer->bytes_to_discard) {
+    return 0 < receive_buffer->length;
+  }
+  if(ENCAPSULATION_HEADER_LENGTH > receive_buffer->length) {
+    return false;
+  }
+  const CipOctet *length_field =
+    &receive_buffer->data[receive_buffer->start + 2];
+  const size_t message_size = GetUintFromMessage(&length_field) +
+                              ENCAPSULATION_HEADER_LENGTH;
+  return message_size <= receive_buffer->length;
+}
+
+size_t TcpReceiveBufferGetMessage(TcpReceiveBuffer *const receive_buffer,
+                                  CipOctet **const message,
+                                  const size_t max_message_size) {
+  while(true) {
+    if(0 < receive_buffer->bytes_to_discard) {
+      size_t discarded =
+        receive_buffer->bytes_to_discard < receive_buffer->length ?
+        receive_buffer->bytes_to_discard : receive_buffer->length;
+      TcpReceiveBufferConsume(receive_buffer, discarded);
+      receive_buffer->bytes_to_discard -= discarded;
+      if(0 < receive_buffer->bytes_to_discard) {
+        return 0;
+      }
+    }
+
+    if(ENCAPSULATION_HEADER_LENGTH > receive_buffer->length) {
+      return 0;
+    }
+
+    /* at this place EIP stores the data length */
+    const CipOctet *length_field =
+      &receive_buffer->data[receive_buffer->start + 2];
+    size_t message_size = GetUintFromMessage(&length_field) +
+                          ENCAPSULATION_HEADER_LENGTH;
+
+    if(max_message_size < message_size ||
+       OPENER_TCP_RECEIVE_BUFFER_SIZE < message_size) {
+      OPENER_TRACE_ERR(
+        "too large packet received will be ignored, will drop the data\n");
+      receive_buffer->bytes_to_discard = message_size;
+      continue;
+    }
+
+    if(message_size > receive_buffer->length) {
+      return 0; /* wait for the rest of the message */
+    }
+
+    *message = &receive_buffer->data[receive_buffer->start];
+    return message_size;
+  }
+}
+
+void TcpReceiveBufferConsume(TcpReceiveBuffer *const receive_buffer,
+                             const size_t number_of_bytes) {
+  OPENER_ASSERT(number_of_bytes <= receive_buffer->length);
+  receive_buffer->start += number_of_bytes;
+  receive_buffer->length -= number_of_bytes;
+  if(0 == receive_buffer->length) {
+    receive_buffer->start = 0;
+  }
+}
+
+void TcpReceiveBufferArrayInitialize(
+  TcpReceiveBuffer *const array_of_receive_buffers,
+  const size_t array_length) {
+  for(size_t i = 0; i < array_length; ++i) {
+    TcpReceiveBufferClear(&array_of_receive_buffers[i]);
+  }
+}
+
+TcpReceiveBuffer *TcpReceiveBufferArrayGetBuffer(
+  TcpReceiveBuffer *const array_of_receive_buffers,
+  const size_t array_length,
+  const int socket) {
+  for(size_t i = 0; i < array_length; ++i) {
+    if(socket == array_of_receive_buffers[i].socket) {
+      return &array_of_receive_buffers[i];
+    }
+  }
+  return NULL;
+}
+
+TcpReceiveBuffer *TcpReceiveBufferArrayGetEmptyBuffer(
+  TcpReceiveBuffer *const array_of_receive_buffers,
+  const size_t array_length) {
+  return TcpReceiveBufferArrayGetBuffer(array_of_receive_buffers,
+                                        array_length,
+                                        kEipInvalidSocket);
+}
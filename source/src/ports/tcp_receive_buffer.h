@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#ifndef SRC_PORTS_TCP_RECEIVE_BUFFER_H_
+#define SRC_PORTS_TCP_RECEIVE_BUFFER_H_
+
+#include "typedefs.h"
+#include "opener_user_conf.h"
+
+/** @brief Size of the receive buffer of each TCP socket
+ *
+ *  Has to hold at least one complete encapsulation message, a bigger buffer
+ *  allows to receive several pipelined requests with a single recv().
+ */
+#ifndef OPENER_TCP_RECEIVE_BUFFER_SIZE
+  #define OPENER_TCP_RECEIVE_BUFFER_SIZE (2 * PC_OPENER_ETHERNET_BUFFER_SIZE)
+#endif
+
+/** @brief Receive buffer of a TCP socket, reassembles the encapsulation
+ *  messages of the stream
+ *
+ *  Received bytes are appended at the end, complete messages are consumed
+ *  from the front. An incomplete message is moved to the start of the buffer
+ *  only when the end of the buffer is reached, so messages are always
+ *  contiguous and can be parsed in place.
+ */
+typedef struct tcp_receive_buffer {
+  int socket; /**< key, kEipInvalidSocket if unused */
+  size_t start; /**< offset of the first unprocessed byte */
+  size_t length; /**< number of unprocessed bytes */
+  size_t bytes_to_discard; /**< remaining bytes of an oversized message being dropped */
+  CipOctet data[OPENER_TCP_RECEIVE_BUFFER_SIZE]; /**< the buffer memory */
+} TcpReceiveBuffer;
+
+/** @brief
+ * Clears a TCP receive buffer entry
+ *
+ * @param receive_buffer TCP receive buffer to be cleared
+ */
+void TcpReceiveBufferClear(TcpReceiveBuffer *const receive_buffer);
+
+/** @brief
+ * Assigns a cleared TCP receive buffer to a socket
+ *
+ * @param receive_buffer TCP receive buffer to be assigned
+ * @param socket Socket handle
+ */
+void TcpReceiveBufferSetSocket(TcpReceiveBuffer *const receive_buffer,
+                               const int socket);
+
+/** @brief
+ * Gets the position where newly received data has to be written to
+ *
+ * @param receive_buffer The TCP receive buffer
+ * @param free_space Returns the number of bytes which can be written
+ * @return Write position inside the buffer
+ */
+CipOctet *TcpReceiveBufferGetWritePosition(
+  TcpReceiveBuffer *const receive_buffer,
+  size_t *const free_space);
+
+/** @brief
+ * Appends data written to the write position to the unprocessed data
+ *
+ * @param receive_buffer The TCP receive buffer
+ * @param number_of_bytes Number of bytes written
+ */
+void TcpReceiveBufferCommit(TcpReceiveBuffer *const receive_buffer,
+                            const size_t number_of_bytes);
+
+/** @brief
+ * Checks if the buffer holds a complete encapsulation message or bytes of a
+ * dropped message, without processing them
+ *
+ * @param receive_buffer The TCP receive buffer
+ * @return true if TcpReceiveBufferGetMessage() has data to work on
+ */
+bool TcpReceiveBufferHasMessage(const TcpReceiveBuffer *const receive_buffer);
+
+/** @brief
+ * Gets the next complete encapsulation message
+ *
+ * Messages bigger than max_message_size are dropped, also if their remaining
+ * bytes are received later on.
+ *
+ * @param receive_buffer The TCP receive buffer
+ * @param message Returns the start of the complete message
+ * @param max_message_size Largest message size which can be processed
+ * @return Size of the complete message, 0 if no complete message is available
+ */
+size_t TcpReceiveBufferGetMessage(TcpReceiveBuffer *const receive_buffer,
+                                  CipOctet **const message,
+                                  const size_t max_message_size);
+
+/** @brief
+ * Removes processed data from the front of the unprocessed data
+ *
+ * @param receive_buffer The TCP receive buffer
+ * @param number_of_bytes Number of processed bytes
+ */
+void TcpReceiveBufferConsume(TcpReceiveBuffer *const receive_buffer,
+                             const size_t number_of_bytes);
+
+/** @brief
+ * Initializes an array of TCP receive buffer entries
+ *
+ * @param array_of_receive_buffers The array to be initialized
+ * @param array_length the length of the array
+ */
+void TcpReceiveBufferArrayInitialize(
+  TcpReceiveBuffer *const array_of_receive_buffers,
+  const size_t array_length);
+
+/** @brief
+ * Get the TCP receive buffer entry of the specified socket
+ *
+ * @param array_of_receive_buffers The TCP receive buffer array
+ * @param array_length The TCP receive buffer array length
+ * @param socket The socket value to be searched for
+ *
+ * @return The TCP receive buffer if found, otherwise NULL
+ */
+TcpReceiveBuffer *TcpReceiveBufferArrayGetBuffer(
+  TcpReceiveBuffer *const array_of_receive_buffers,
+  const size_t array_length,
+  const int socket);
+
+/** @brief
+ * Get an unused TCP receive buffer entry
+ *
+ * @param array_of_receive_buffers The TCP receive buffer array
+ * @param array_length The TCP receive buffer array length
+ *
+ * @return An unused entry, or NULL if none is available
+ */
+TcpReceiveBuffer *TcpReceiveBufferArrayGetEmptyBuffer(
+  TcpReceiveBuffer *const array_of_receive_buffers,
+  const size_t array_length);
+
+#endif /* SRC_PORTS_TCP_RECEIVE_BUFFER_H_ */
@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+
+#include "tcp_send_queue.h"
+
+#include "trace.h"
+
+#if OPENER_TCP_SEND_QUEUE_SIZE <= PC_OPENER_ETHERNET_BUFFER_SIZE
+  #error "OPENER_TCP_SEND_QUEUE_SIZE has to be bigger than the Ethernet buffer"
+#endif
+
+void TcpSendQueueClear(TcpSendQueue *const send_queue) {
+  send_queue->socket = kEipInvalidSocket;
+  send_queue->start = 0;
+  send_queue->length = 0;
+  send_queue->watched_events = 0;
+}
+
+void TcpSendQueueSetSocket(TcpSendQueue *const send_queue,
+                           const int socket) {
+  TcpSendQueueClear(send_queue);
+  send_queue->socket = socket;
+}
+
+bool TcpSendQueueIsEmpty(const TcpSendQueue *const send_queue) {
+  return 0 == send_queue->length;
+}
+
+bool TcpSendQueueCanTakeMessage(const TcpSendQueue *const send_queue) {
+  return OPENER_TCP_SEND_QUEUE_SIZE - send_queue->length >=
+         PC_OPENER_ETHERNET_BUFFER_SIZE;
+}
+
+EipStatus TcpSendQueueAppend(TcpSendQueue *const send_queue,
+                             const CipOctet *const data,
+                             const size_t number_of_bytes) {
+  if(OPENER_TCP_SEND_QUEUE_SIZE - send_queue->length < number_of_bytes) {
+    return kEipStatusError;
+  }
+  if(OPENER_TCP_SEND_QUEUE_SIZE - send_queue->start - send_queue->length <
+     number_of_bytes) {
+    /* end reached, move the unsent bytes to the front */
+    memmove(send_queue->data,
+            &send_queue->data[send_queue->start],
+            send_queue->length);
+    send_queue->start = 0;
+  }
+  memcpy(&send_queue->data[send_queue->start + send_queue->length],
+         data,
+         number_of_bytes);
+  send_queue->length += number_of_bytes;
+  return kEipStatusOk;
+}
+
+const CipOctet *TcpSendQueueGetData(const TcpSendQueue *const send_queue,
+                                    size_t *const number_of_bytes) {
+  *number_of_bytes = send_queue->length;
+  return &send_queue->data[send_queue->start];
+}
+
+void TcpSendQueueConsume(TcpSendQueue *const send_queue,
+                         const size_t number_of_bytes) {
+  OPENER_ASSERT(number_of_bytes <= send_queue->length);
+  send_queue->start += number_of_bytes;
+  send_queue->length -= number_of_bytes;
+  if(0 == send_queue->length) {
+    send_queue->start = 0;
+  }
+}
+
+void TcpSendQueueArrayInitialize(TcpSendQueue *const array_of_send_queues,
+                                 const size_t array_length) {
+  for(size_t i = 0; i < array_length; ++i) {
+    TcpSendQueueClear(&array_of_send_queues[i]);
+  }
+}
+
+TcpSendQueue *TcpSendQueueArrayGetQueue(
+  TcpSendQueue *const array_of_send_queues,
+  const size_t array_length,
+  const int socket) {
+  for(size_t i = 0; i < array_length; ++i) {
+    if(socket == array_of_send_queues[i].socket) {
+      return &array_of_send_queues[i];
+    }
+  }
+  return NULL;
+}
+
+TcpSendQueue *TcpSendQueueArrayGetEmptyQueue(
+  TcpSendQueue *const array_of_send_queues,
+  const size_t array_length) {
+  return TcpSendQueueArrayGetQueue(array_of_send_queues,
+                                   array_length,
+                                   kEipInvalidSocket);
+}
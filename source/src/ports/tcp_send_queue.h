@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#ifndef SRC_PORTS_TCP_SEND_QUEUE_H_
+#define SRC_PORTS_TCP_SEND_QUEUE_H_
+
+#include "typedefs.h"
+#include "opener_user_conf.h"
+
+/** @brief Size of the send queue of each TCP socket
+ *
+ *  Holds the reply bytes the socket did not take. No further requests of a
+ *  session are handled while less than one Ethernet message buffer is free,
+ *  so the queue has to be bigger than PC_OPENER_ETHERNET_BUFFER_SIZE.
+ */
+#ifndef OPENER_TCP_SEND_QUEUE_SIZE
+  #define OPENER_TCP_SEND_QUEUE_SIZE (4 * PC_OPENER_ETHERNET_BUFFER_SIZE)
+#endif
+
+/** @brief Send queue of a TCP socket, keeps the unsent part of the replies
+ *  in order until the socket is writable again
+ *
+ *  Bytes are appended at the end and sent from the front. The unsent bytes are
+ *  moved to the start of the queue only when an append does not fit at the
+ *  end, so they can always be sent with a single send().
+ */
+typedef struct tcp_send_queue {
+  int socket; /**< key, kEipInvalidSocket if unused */
+  size_t start; /**< offset of the first unsent byte */
+  size_t length; /**< number of unsent bytes */
+  unsigned int watched_events; /**< events the socket is watched for, see NetworkEventType */
+  CipOctet data[OPENER_TCP_SEND_QUEUE_SIZE]; /**< the queue memory */
+} TcpSendQueue;
+
+/** @brief
+ * Clears a TCP send queue entry
+ *
+ * @param send_queue TCP send queue to be cleared
+ */
+void TcpSendQueueClear(TcpSendQueue *const send_queue);
+
+/** @brief
+ * Assigns a cleared TCP send queue to a socket
+ *
+ * @param send_queue TCP send queue to be assigned
+ * @param socket Socket handle
+ */
+void TcpSendQueueSetSocket(TcpSendQueue *const send_queue,
+                           const int socket);
+
+/** @brief
+ * Checks if the queue holds unsent bytes
+ *
+ * @param send_queue The TCP send queue
+ * @return true if there are no unsent bytes
+ */
+bool TcpSendQueueIsEmpty(const TcpSendQueue *const send_queue);
+
+/** @brief
+ * Checks if the queue can take the reply to one more request
+ *
+ * @param send_queue The TCP send queue
+ * @return true if at least PC_OPENER_ETHERNET_BUFFER_SIZE bytes are free
+ */
+bool TcpSendQueueCanTakeMessage(const TcpSendQueue *const send_queue);
+
+/** @brief
+ * Appends bytes to the end of the unsent bytes
+ *
+ * @param send_queue The TCP send queue
+ * @param data The bytes to be appended
+ * @param number_of_bytes Number of bytes to be appended
+ * @return kEipStatusOk on success, kEipStatusError if they do not fit
+ */
+EipStatus TcpSendQueueAppend(TcpSendQueue *const send_queue,
+                             const CipOctet *const data,
+                             const size_t number_of_bytes);
+
+/** @brief
+ * Gets the unsent bytes
+ *
+ * @param send_queue The TCP send queue
+ * @param number_of_bytes Returns the number of unsent bytes
+ * @return Start of the unsent bytes
+ */
+const CipOctet *TcpSendQueueGetData(const TcpSendQueue *const send_queue,
+                                    size_t *const number_of_bytes);
+
+/** @brief
+ * Removes sent bytes from the front of the unsent bytes
+ *
+ * @param send_queue The TCP send queue
+ * @param number_of_bytes Number of sent bytes
+ */
+void TcpSendQueueConsume(TcpSendQueue *const send_queue,
+                         const size_t number_of_bytes);
+
+/** @brief
+ * Initializes an array of TCP send queue entries
+ *
+ * @param array_of_send_queues The array to be initialized
+ * @param array_length the length of the array
+ */
+void TcpSendQueueArrayInitialize(TcpSendQueue *const array_of_send_queues,
+                                 const size_t array_length);
+
+/** @brief
+ * Get the TCP send queue entry of the specified socket
+ *
+ * @param array_of_send_queues The TCP send queue array
+ * @param array_length The TCP send queue array length
+ * @param socket The socket value to be searched for
+ *
+ * @return The TCP send queue if found, otherwise NULL
+ */
+TcpSendQueue *TcpSendQueueArrayGetQueue(
+  TcpSendQueue *const array_of_send_queues,
+  const size_t array_length,
+  const int socket);
+
+/** @brief
+ * Get an unused TCP send queue entry
+ *
+ * @param array_of_send_queues The TCP send queue array
+ * @param array_length The TCP send queue array length
+ *
+ * @return An unused entry, or NULL if none is available
+ */
+TcpSendQueue *TcpSendQueueArrayGetEmptyQueue(
+  TcpSendQueue *const array_of_send_queues,
+  const size_t array_length);
+
+#endif /* SRC_PORTS_TCP_SEND_QUEUE_H_ */
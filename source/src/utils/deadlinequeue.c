@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include "deadlinequeue.h"
+
+static void DeadlineQueuePlace(DeadlineQueue *const queue,
+                               DeadlineQueueEntry *const entry,
+                               const size_t position) {
+  queue->heap[position] = entry;
+  entry->position = position;
+}
+
+static void DeadlineQueueSiftUp(DeadlineQueue *const queue,
+                                DeadlineQueueEntry *const entry) {
+  size_t position = entry->position;
+  while(0 < position) {
+    size_t parent = (position - 1) / 2;
+    if(queue->heap[parent]->deadline <= entry->deadline) {
+      break;
+    }
+    DeadlineQueuePlace(queue, queue->heap[parent], position);
+    position = parent;
+  }
+  DeadlineQueuePlace(queue, entry, position);
+}
+
+static void DeadlineQueueSiftDown(DeadlineQueue *const queue,
+                                  DeadlineQueueEntry *const entry) {
+  size_t position = entry->position;
+  while(true) {
+    size_t child = 2 * position + 1;
+    if(child >= queue->length) {
+      break;
+    }
+    if(child + 1 < queue->length &&
+       queue->heap[child + 1]->deadline < queue->heap[child]->deadline) {
+      child++;
+    }
+    if(entry->deadline <= queue->heap[child]->deadline) {
+      break;
+    }
+    DeadlineQueuePlace(queue, queue->heap[child], position);
+    position = child;
+  }
+  DeadlineQueuePlace(queue, entry, position);
+}
+
+void DeadlineQueueInitialize(DeadlineQueue *const queue,
+                             DeadlineQueueEntry **const storage,
+                             const size_t capacity) {
+  queue->heap = storage;
+  queue->capacity = capacity;
+  queue->length = 0;
+}
+
+void DeadlineQueueEntryInitialize(DeadlineQueueEntry *const entry,
+                                  void *const data) {
+  entry->deadline = 0;
+  entry->position = DEADLINE_QUEUE_NOT_QUEUED;
+  entry->data = data;
+}
+
+bool DeadlineQueueEntryIsQueued(const DeadlineQueueEntry *const entry) {
+  return DEADLINE_QUEUE_NOT_QUEUED != entry->position;
+}
+
+bool DeadlineQueueSchedule(DeadlineQueue *const queue,
+                           DeadlineQueueEntry *const entry,
+                           const uint64_t deadline) {
+  if(!DeadlineQueueEntryIsQueued(entry) ) {
+    if(queue->length >= queue->capacity) {
+      return false;
+    }
+    entry->deadline = deadline;
+    entry->position = queue->length++;
+    DeadlineQueueSiftUp(queue, entry);
+    return true;
+  }
+
+  uint64_t previous_deadline = entry->deadline;
+  entry->deadline = deadline;
+  if(deadline < previous_deadline) {
+    DeadlineQueueSiftUp(queue, entry);
+  } else {
+    DeadlineQueueSiftDown(queue, entry);
+  }
+  return true;
+}
+
+void DeadlineQueueCancel(DeadlineQueue *const queue,
+                         DeadlineQueueEntry *const entry) {
+  if(!DeadlineQueueEntryIsQueued(entry) ) {
+    return;
+  }
+  size_t position = entry->position;
+  entry->position = DEADLINE_QUEUE_NOT_QUEUED;
+  queue->length--;
+  if(position == queue->length) {
+    return; /* was the last entry */
+  }
+  /* fill the gap with the last entry and restore the heap order */
+  DeadlineQueueEntry *const last = queue->heap[queue->length];
+  last->position = position;
+  if(0 < position &&
+     last->deadline < queue->heap[(position - 1) / 2]->deadline) {
+    DeadlineQueueSiftUp(queue, last);
+  } else {
+    DeadlineQueueSiftDown(queue, last);
+  }
+}
+
+DeadlineQueueEntry *DeadlineQueuePeek(const DeadlineQueue *const queue) {
+  return 0 < queue->length ? queue->heap[0] : NULL;
+}
+
+DeadlineQueueEntry *DeadlineQueuePopExpired(DeadlineQueue *const queue,
+                                            const uint64_t current_time) {
+  DeadlineQueueEntry *const earliest = DeadlineQueuePeek(queue);
+  if(NULL == earliest || earliest->deadline > current_time) {
+    return NULL;
+  }
+  DeadlineQueueCancel(queue, earliest);
+  return earliest;
+}
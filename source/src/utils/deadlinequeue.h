@@ -0,0 +1,73 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#ifndef SRC_UTILS_DEADLINEQUEUE_H_
+#define SRC_UTILS_DEADLINEQUEUE_H_
+
+/**
+ * @file deadlinequeue.h
+ *
+ * The public interface for a reference type priority queue of absolute
+ * deadlines, implemented as binary min-heap.
+ *
+ * The entries are owned by the user, e.g., embedded in the object the deadline
+ * belongs to, the queue only stores pointers to them. Scheduling, cancelling
+ * and removing the earliest entry take O(log n), looking up the earliest
+ * deadline O(1).
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Position of an entry which is not queued */
+#define DEADLINE_QUEUE_NOT_QUEUED SIZE_MAX
+
+typedef struct deadline_queue_entry {
+  uint64_t deadline; /**< absolute expiry time */
+  size_t position; /**< index in the heap, DEADLINE_QUEUE_NOT_QUEUED if not queued */
+  void *data; /**< the object the deadline belongs to */
+} DeadlineQueueEntry;
+
+typedef struct {
+  DeadlineQueueEntry **heap; /**< storage of the heap */
+  size_t capacity; /**< number of entries fitting into the storage */
+  size_t length; /**< number of queued entries */
+} DeadlineQueue;
+
+void DeadlineQueueInitialize(DeadlineQueue *const queue,
+                             DeadlineQueueEntry **const storage,
+                             const size_t capacity);
+
+void DeadlineQueueEntryInitialize(DeadlineQueueEntry *const entry,
+                                  void *const data);
+
+bool DeadlineQueueEntryIsQueued(const DeadlineQueueEntry *const entry);
+
+/** @brief Queues an entry or moves an already queued entry to a new deadline
+ *
+ * @return false if the entry is not queued and the queue is full
+ */
+bool DeadlineQueueSchedule(DeadlineQueue *const queue,
+                           DeadlineQueueEntry *const entry,
+                           const uint64_t deadline);
+
+/** @brief Removes an entry from the queue, nothing happens if it is not queued
+ */
+void DeadlineQueueCancel(DeadlineQueue *const queue,
+                         DeadlineQueueEntry *const entry);
+
+/** @brief Gets the entry with the earliest deadline, NULL if the queue is empty
+ */
+DeadlineQueueEntry *DeadlineQueuePeek(const DeadlineQueue *const queue);
+
+/** @brief Removes and returns the earliest entry if its deadline is not later
+ * than the given time, NULL otherwise
+ */
+DeadlineQueueEntry *DeadlineQueuePopExpired(DeadlineQueue *const queue,
+                                            const uint64_t current_time);
+
+#endif /* SRC_UTILS_DEADLINEQUEUE_H_ */
@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include "hashindex.h"
+
+/** @brief Spreads the key over all bits, consecutive keys like connection IDs
+ * are mapped to distant slots (Fibonacci hashing) */
+static size_t HashIndexHomeSlot(const HashIndex *const index,
+                                const uint32_t key) {
+  uint32_t hash = key * UINT32_C(2654435769);
+  hash ^= hash >> 16;
+  return hash & (index->capacity - 1);
+}
+
+static size_t HashIndexNextSlot(const HashIndex *const index,
+                                const size_t slot) {
+  return (slot + 1) & (index->capacity - 1);
+}
+
+void HashIndexInitialize(HashIndex *const index,
+                         HashIndexEntry *const storage,
+                         const size_t capacity) {
+  size_t power_of_two = 1;
+  while(power_of_two <= capacity / 2) {
+    power_of_two *= 2;
+  }
+  index->slots = storage;
+  index->capacity = (0 == capacity) ? 0 : power_of_two;
+  index->length = 0;
+  for(size_t i = 0; i < index->capacity; ++i) {
+    index->slots[i].key = 0;
+    index->slots[i].data = NULL;
+  }
+}
+
+bool HashIndexInsert(HashIndex *const index,
+                     const uint32_t key,
+                     void *const data) {
+  if(NULL == data || index->length + 1 >= index->capacity) {
+    return false;
+  }
+  size_t slot = HashIndexHomeSlot(index, key);
+  while(NULL != index->slots[slot].data) {
+    slot = HashIndexNextSlot(index, slot);
+  }
+  index->slots[slot].key = key;
+  index->slots[slot].data = data;
+  index->length++;
+  return true;
+}
+
+bool HashIndexRemove(HashIndex *const index,
+                     const uint32_t key,
+                     const void *const data) {
+  if(0 == index->capacity) {
+    return false;
+  }
+  size_t slot = HashIndexHomeSlot(index, key);
+  while(NULL != index->slots[slot].data) {
+    if(key == index->slots[slot].key && data == index->slots[slot].data) {
+      break;
+    }
+    slot = HashIndexNextSlot(index, slot);
+  }
+  if(NULL == index->slots[slot].data) {
+    return false;
+  }
+  /* moves the following entries of the probe sequence back into the gap, so
+   * lookups still terminate at the first free slot */
+  size_t gap = slot;
+  size_t next = HashIndexNextSlot(index, gap);
+  while(NULL != index->slots[next].data) {
+    const size_t home = HashIndexHomeSlot(index, index->slots[next].key);
+    /* the entry may fill the gap if its home slot is not between gap and it */
+    const size_t distance_to_entry = (next - home) & (index->capacity - 1);
+    const size_t distance_to_gap = (next - gap) & (index->capacity - 1);
+    if(distance_to_entry >= distance_to_gap) {
+      index->slots[gap] = index->slots[next];
+      gap = next;
+    }
+    next = HashIndexNextSlot(index, next);
+  }
+  index->slots[gap].key = 0;
+  index->slots[gap].data = NULL;
+  index->length--;
+  return true;
+}
+
+void *HashIndexFind(const HashIndex *const index,
+                    const uint32_t key,
+                    HashIndexAcceptFunction accept,
+                    const void *const context) {
+  if(0 == index->capacity) {
+    return NULL;
+  }
+  for(size_t slot = HashIndexHomeSlot(index, key);
+      NULL != index->slots[slot].data;
+      slot = HashIndexNextSlot(index, slot) ) {
+    if(key == index->slots[slot].key &&
+       (NULL == accept || accept(index->slots[slot].data, context) ) ) {
+      return index->slots[slot].data;
+    }
+  }
+  return NULL;
+}
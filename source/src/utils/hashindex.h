@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#ifndef SRC_UTILS_HASHINDEX_H_
+#define SRC_UTILS_HASHINDEX_H_
+
+/**
+ * @file hashindex.h
+ *
+ * The public interface for an index of objects by a 32 bit key, implemented as
+ * open addressing hash table with linear probing.
+ *
+ * The objects are owned by the user, the index only stores pointers to them.
+ * A key may be used by several objects. Inserting, removing and looking up
+ * take O(1) on average as long as the index is at most half full.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct hash_index_entry {
+  uint32_t key; /**< the key the object is found by */
+  void *data; /**< the indexed object, NULL if the slot is free */
+} HashIndexEntry;
+
+typedef struct {
+  HashIndexEntry *slots; /**< storage of the hash table */
+  size_t capacity; /**< number of slots, a power of two */
+  size_t length; /**< number of indexed objects */
+} HashIndex;
+
+/** @brief Decides if an object found by its key is the one looked for
+ *
+ * @param data The object indexed by the key
+ * @param context The context passed to HashIndexFind()
+ */
+typedef bool (*HashIndexAcceptFunction)(const void *const data,
+                                        const void *const context);
+
+/** @brief Initializes an empty index
+ *
+ * @param index The index
+ * @param storage The slots of the hash table
+ * @param capacity The number of slots of the storage, only the largest power
+ *  of two not exceeding it is used
+ */
+void HashIndexInitialize(HashIndex *const index,
+                         HashIndexEntry *const storage,
+                         const size_t capacity);
+
+/** @brief Adds an object to the index
+ *
+ * @return false if the index is full, one slot is always kept free
+ */
+bool HashIndexInsert(HashIndex *const index,
+                     const uint32_t key,
+                     void *const data);
+
+/** @brief Removes an object from the index
+ *
+ * @return false if the object is not indexed by the key
+ */
+bool HashIndexRemove(HashIndex *const index,
+                     const uint32_t key,
+                     const void *const data);
+
+/** @brief Looks up an object by its key
+ *
+ * @param index The index
+ * @param key The key of the object
+ * @param accept Checks the objects indexed by the key, NULL to accept any
+ * @param context Passed to the accept function, e.g., the full key if keys
+ *  of different objects may collide
+ * @return The first accepted object of the key, NULL if there is none
+ */
+void *HashIndexFind(const HashIndex *const index,
+                    const uint32_t key,
+                    HashIndexAcceptFunction accept,
+                    const void *const context);
+
+#endif /* SRC_UTILS_HASHINDEX_H_ */
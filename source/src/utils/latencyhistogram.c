@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <string.h>
+
+#include "latencyhistogram.h"
+
+void LatencyHistogramInitialize(LatencyHistogram *const histogram) {
+  memset( histogram, 0, sizeof(*histogram) );
+}
+
+size_t LatencyHistogramGetBucket(const uint64_t latency) {
+  size_t bucket = 0;
+  uint64_t remaining = latency;
+  while(0 != remaining && LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1 > bucket) {
+    remaining >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void LatencyHistogramAdd(LatencyHistogram *const histogram,
+                         const uint64_t latency) {
+  histogram->buckets[LatencyHistogramGetBucket(latency)]++;
+  histogram->count++;
+  histogram->sum += latency;
+  if(latency > histogram->max) {
+    histogram->max = latency;
+  }
+}
+
+uint64_t LatencyHistogramGetMean(const LatencyHistogram *const histogram) {
+  if(0 == histogram->count) {
+    return 0;
+  }
+  return histogram->sum / histogram->count;
+}
+
+uint64_t LatencyHistogramGetPercentile(const LatencyHistogram *const histogram,
+                                       const unsigned int percent) {
+  /* number of latencies at or below the percentile, rounded up */
+  const uint64_t rank = ( (uint64_t) histogram->count * percent + 99 ) / 100;
+  uint64_t counted = 0;
+  for(size_t bucket = 0; bucket < LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1;
+      bucket++) {
+    counted += histogram->buckets[bucket];
+    if(0 < counted && counted >= rank) {
+      const uint64_t bucket_end = ( (uint64_t) 1 << bucket ) - 1;
+      return bucket_end < histogram->max ? bucket_end : histogram->max;
+    }
+  }
+  return histogram->max;
+}
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#ifndef SRC_UTILS_LATENCYHISTOGRAM_H_
+#define SRC_UTILS_LATENCYHISTOGRAM_H_
+
+/**
+ * @file latencyhistogram.h
+ *
+ * Histogram of latencies in microseconds with power of two bucket sizes.
+ *
+ * Bucket 0 counts latencies of 0 us, bucket i > 0 the latencies from
+ * 2^(i-1) us to 2^i - 1 us, the last bucket additionally all larger ones.
+ * Adding a latency takes constant time and no memory besides the histogram.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Number of buckets, the last one starts at 2^14 us = 16.4 ms */
+#define LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS 16
+
+typedef struct {
+  uint32_t buckets[LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS]; /**< number of latencies per bucket */
+  uint32_t count; /**< number of added latencies */
+  uint64_t sum; /**< sum of the added latencies */
+  uint64_t max; /**< largest added latency */
+} LatencyHistogram;
+
+void LatencyHistogramInitialize(LatencyHistogram *const histogram);
+
+/** @brief Gets the bucket counting a latency */
+size_t LatencyHistogramGetBucket(const uint64_t latency);
+
+void LatencyHistogramAdd(LatencyHistogram *const histogram,
+                         const uint64_t latency);
+
+/** @brief Gets the mean of the added latencies, 0 if the histogram is empty
+ */
+uint64_t LatencyHistogramGetMean(const LatencyHistogram *const histogram);
+
+/** @brief Gets an upper bound of a percentile of the added latencies
+ *
+ * @param histogram The histogram
+ * @param percent The percentile from 1 to 100
+ * @return The largest latency of the bucket the percentile falls into, not
+ *  exceeding the largest added latency, 0 if the histogram is empty
+ */
+uint64_t LatencyHistogramGetPercentile(const LatencyHistogram *const histogram,
+                                       const unsigned int percent);
+
+#endif /* SRC_UTILS_LATENCYHISTOGRAM_H_ */
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include "messagebufferpool.h"
+
+/** @brief Index of the smallest size class fitting the size,
+ * MESSAGE_BUFFER_POOL_SIZE_CLASSES if the size is too large */
+static size_t MessageBufferPoolSizeClass(const size_t size) {
+  size_t size_class = 0;
+  size_t capacity = MESSAGE_BUFFER_POOL_MINIMUM_CAPACITY;
+  while(capacity < size && size_class < MESSAGE_BUFFER_POOL_SIZE_CLASSES) {
+    capacity *= 2;
+    size_class++;
+  }
+  return size_class;
+}
+
+void MessageBufferPoolInitialize(MessageBufferPool *const pool,
+                                 const MessageBufferAllocator allocator,
+                                 const MessageBufferDeallocator deallocator) {
+  for(size_t i = 0; i < MESSAGE_BUFFER_POOL_SIZE_CLASSES; ++i) {
+    pool->free_buffers[i] = NULL;
+  }
+  pool->allocated_buffers = NULL;
+  pool->allocated_capacity = 0;
+  pool->allocator = allocator;
+  pool->deallocator = deallocator;
+}
+
+void MessageBufferPoolDestroy(MessageBufferPool *const pool) {
+  MessageBuffer *buffer = pool->allocated_buffers;
+  while(NULL != buffer) {
+    MessageBuffer *const to_delete = buffer;
+    buffer = buffer->next_allocated;
+    pool->deallocator(to_delete);
+  }
+  MessageBufferPoolInitialize(pool, pool->allocator, pool->deallocator);
+}
+
+MessageBuffer *MessageBufferPoolAcquire(MessageBufferPool *const pool,
+                                        const size_t size) {
+  const size_t size_class = MessageBufferPoolSizeClass(size);
+  if(MESSAGE_BUFFER_POOL_SIZE_CLASSES <= size_class) {
+    return NULL;
+  }
+  MessageBuffer *buffer = pool->free_buffers[size_class];
+  if(NULL != buffer) {
+    pool->free_buffers[size_class] = buffer->next_free;
+    buffer->next_free = NULL;
+    return buffer;
+  }
+
+  const size_t capacity =
+    (size_t) MESSAGE_BUFFER_POOL_MINIMUM_CAPACITY << size_class;
+  buffer = pool->allocator(1, sizeof(MessageBuffer) + capacity);
+  if(NULL == buffer) {
+    return NULL;
+  }
+  buffer->next_free = NULL;
+  buffer->next_allocated = pool->allocated_buffers;
+  buffer->capacity = capacity;
+  pool->allocated_buffers = buffer;
+  pool->allocated_capacity += capacity;
+  return buffer;
+}
+
+void MessageBufferPoolRelease(MessageBufferPool *const pool,
+                              MessageBuffer *const buffer) {
+  if(NULL == buffer) {
+    return;
+  }
+  const size_t size_class = MessageBufferPoolSizeClass(buffer->capacity);
+  buffer->next_free = pool->free_buffers[size_class];
+  pool->free_buffers[size_class] = buffer;
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#ifndef SRC_UTILS_MESSAGEBUFFERPOOL_H_
+#define SRC_UTILS_MESSAGEBUFFERPOOL_H_
+
+/**
+ * @file messagebufferpool.h
+ *
+ * The public interface for a pool of message buffers of varying size.
+ *
+ * Buffers are handed out in power of two size classes. Released buffers are
+ * kept for the next request of their size class, so memory is only allocated
+ * until the pool holds the largest number of buffers of each class used at
+ * the same time. Large buffers are only allocated for users requesting them.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Smallest capacity of a message buffer */
+#define MESSAGE_BUFFER_POOL_MINIMUM_CAPACITY 64
+
+/** @brief Number of size classes, the largest one holds 64 KiB */
+#define MESSAGE_BUFFER_POOL_SIZE_CLASSES 11
+
+typedef struct message_buffer {
+  struct message_buffer *next_free; /**< next released buffer of the size class */
+  struct message_buffer *next_allocated; /**< next buffer allocated by the pool */
+  size_t capacity; /**< usable size of data */
+  uint8_t data[]; /**< the message */
+} MessageBuffer;
+
+/** @brief Allocates zeroed memory, the signature of calloc */
+typedef void *(*MessageBufferAllocator)(size_t number_of_elements,
+                                        size_t size_of_element);
+
+/** @brief Frees memory of the MessageBufferAllocator */
+typedef void (*MessageBufferDeallocator)(void *memory);
+
+typedef struct {
+  MessageBuffer *free_buffers[MESSAGE_BUFFER_POOL_SIZE_CLASSES]; /**< released buffers per size class */
+  MessageBuffer *allocated_buffers; /**< all buffers of the pool */
+  size_t allocated_capacity; /**< summed capacity of all buffers */
+  MessageBufferAllocator allocator;
+  MessageBufferDeallocator deallocator;
+} MessageBufferPool;
+
+/** @brief Initializes an empty pool
+ *
+ * @param pool The pool
+ * @param allocator Allocates the buffers, e.g., CipCalloc
+ * @param deallocator Frees the buffers, e.g., CipFree
+ */
+void MessageBufferPoolInitialize(MessageBufferPool *const pool,
+                                 const MessageBufferAllocator allocator,
+                                 const MessageBufferDeallocator deallocator);
+
+/** @brief Frees all buffers of the pool, including the ones not released */
+void MessageBufferPoolDestroy(MessageBufferPool *const pool);
+
+/** @brief Takes a buffer of at least the requested size from the pool
+ *
+ * @param pool The pool
+ * @param size The needed size of the buffer
+ * @return A buffer of the smallest size class fitting the size, NULL if the
+ *  size exceeds the largest size class or no memory is left
+ */
+MessageBuffer *MessageBufferPoolAcquire(MessageBufferPool *const pool,
+                                        const size_t size);
+
+/** @brief Returns a buffer to the pool for the next request of its size class
+ *
+ * The content of the buffer is not changed.
+ * @param pool The pool the buffer was taken from
+ * @param buffer The buffer, NULL is ignored
+ */
+void MessageBufferPoolRelease(MessageBufferPool *const pool,
+                              MessageBuffer *const buffer);
+
+#endif /* SRC_UTILS_MESSAGEBUFFERPOOL_H_ */
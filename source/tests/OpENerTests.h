@@ -10,6 +10,19 @@ IMPORT_TEST_GROUP (CipElectronicKeyFormat);
 IMPORT_TEST_GROUP (CipConnectionManager);
 IMPORT_TEST_GROUP (CipConnectionObject);
 IMPORT_TEST_GROUP (SocketTimer);
+IMPORT_TEST_GROUP (TcpReceiveBuffer);
+IMPORT_TEST_GROUP (TcpSendQueue);
+IMPORT_TEST_GROUP (NetworkEvent);
+#if defined(OPENER_IO_SOCKET_FILTER)
+IMPORT_TEST_GROUP (IoSocketFilter);
+#endif
+#if defined(OPENER_IO_TIMESTAMPING)
+IMPORT_TEST_GROUP (IoTimestamping);
+#endif
 IMPORT_TEST_GROUP (DoublyLinkedList);
+IMPORT_TEST_GROUP (DeadlineQueue);
+IMPORT_TEST_GROUP (LatencyHistogram);
+IMPORT_TEST_GROUP (HashIndex);
+IMPORT_TEST_GROUP (MessageBufferPool);
 IMPORT_TEST_GROUP (EncapsulationProtocol);
 IMPORT_TEST_GROUP (CipString);
@@ -5,16 +5,312 @@
  ******************************************************************************/
 
 #include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
 #include <stdint.h>
 #include <string.h>
 
 extern "C" {
 
 #include "cipconnectionmanager.h"
+#include "cipconnectionobject.h"
+#include "opener_api.h"
+#include "appcontype.h"
+#include "messagebufferpool.h"
 
+EipStatus InitializeConnectionManagerData(void);
+EipStatus SendConnectedData(CipConnectionObject *connection_object);
+CipConnectionObject *CheckForExistingConnection(
+  const CipConnectionObject *const connection_object);
+
+}
+
+static int s_productions = 0;
+
+static EipStatus CountProduction(CipConnectionObject *connection_object) {
+  (void) connection_object;
+  s_productions++;
+  return kEipStatusOk;
+}
+
+static void RemoveConnection(CipConnectionObject *connection_object) {
+  RemoveFromActiveConnections(connection_object);
+  ConnectionObjectSetState(connection_object,
+                           kConnectionObjectStateNonExistent);
 }
 
 TEST_GROUP(CipConnectionManager) {
+  CipConnectionObject connections[3];
+
+  void setup() {
+    /* only the calls expected by a test are checked, e.g. not the allocations */
+    mock().ignoreOtherCalls();
+    DoublyLinkedListInitialize(&connection_list,
+                               CipConnectionObjectListArrayAllocator,
+                               CipConnectionObjectListArrayFree);
+    CHECK_EQUAL( kEipStatusOk, InitializeConnectionManagerData() );
+    for(size_t i = 0; i < 3; ++i) {
+      ConnectionObjectInitializeEmpty(&connections[i]);
+      ConnectionObjectSetCipConsumedConnectionID(&connections[i], 0x100 + i);
+    }
+  }
+
+  void teardown() {
+    for(size_t i = 0; i < 3; ++i) {
+      if(kConnectionObjectStateNonExistent !=
+         ConnectionObjectGetState(&connections[i]) ) {
+        RemoveFromActiveConnections(&connections[i]);
+      }
+    }
+    ShutdownConnectionManager();
+  }
+
+  void SetTriad(CipConnectionObject *const connection,
+                const EipUint16 connection_serial_number,
+                const EipUint16 originator_vendor_id,
+                const EipUint32 originator_serial_number) {
+    connection->connection_serial_number = connection_serial_number;
+    connection->originator_vendor_id = originator_vendor_id;
+    connection->originator_serial_number = originator_serial_number;
+  }
+
+  void SetProducing(CipConnectionObject *const connection,
+                    const CipUdint requested_packet_interval) {
+    connection->t_to_o_requested_packet_interval = requested_packet_interval;
+    connection->expected_packet_rate = 10;
+    connection->socket[kUdpCommuncationDirectionProducing] = 1;
+  }
+
+  void SetTriggered(CipConnectionObject *const connection,
+                    const CipByte production_trigger) {
+    SetProducing(connection, 10000);
+    ConnectionObjectSetInstanceType(connection,
+                                    kConnectionObjectInstanceTypeIOExclusiveOwner);
+    connection->transport_class_trigger = production_trigger | 0x01;
+    connection->consumed_path.instance_id = 150;
+    connection->produced_path.instance_id = 100;
+    connection->connection_send_data_function = CountProduction;
+    s_productions = 0;
+  }
 
+  void SetIoConnection(CipConnectionObject *const connection,
+                       const ConnectionObjectInstanceType instance_type,
+                       const CipInstanceNum output_assembly,
+                       const CipInstanceNum input_assembly) {
+    ConnectionObjectSetInstanceType(connection, instance_type);
+    connection->consumed_path.instance_id = output_assembly;
+    connection->produced_path.instance_id = input_assembly;
+    connection->connection_close_function = RemoveConnection;
+  }
+
+  MicroSeconds GetPhase(const CipConnectionObject *const connection) {
+    return connection->transmission_trigger_timer.deadline %
+           ConnectionObjectGetRequestedPacketInterval(connection);
+  }
 };
 
+TEST(CipConnectionManager, ExistingConnectionIsFoundByTriad) {
+  SetTriad(&connections[0], 0x1234, 0x0001, 0xCAFE0000);
+  AddNewActiveConnection(&connections[0]);
+  SetTriad(&connections[1], 0x1234, 0x0001, 0xCAFE0000);
+  POINTERS_EQUAL( &connections[0],
+                  CheckForExistingConnection(&connections[1]) );
+  SetTriad(&connections[1], 0x1235, 0x0001, 0xCAFE0000);
+  POINTERS_EQUAL( NULL, CheckForExistingConnection(&connections[1]) );
+}
+
+TEST(CipConnectionManager, TriadsWithSameKeyAreTold) {
+  /* the serial numbers swap places in the key of the triad index */
+  SetTriad(&connections[0], 0x0001, 0x0000, 0x00000000);
+  SetTriad(&connections[1], 0x0000, 0x0000, 0x00000001);
+  AddNewActiveConnection(&connections[0]);
+  AddNewActiveConnection(&connections[1]);
+  POINTERS_EQUAL( &connections[0],
+                  CheckForExistingConnection(&connections[0]) );
+  POINTERS_EQUAL( &connections[1],
+                  CheckForExistingConnection(&connections[1]) );
+  SetTriad(&connections[2], 0x0001, 0x0000, 0x00000001);
+  POINTERS_EQUAL( NULL, CheckForExistingConnection(&connections[2]) );
+}
+
+TEST(CipConnectionManager, RemovedConnectionIsNotFound) {
+  SetTriad(&connections[0], 0x0001, 0x0000, 0x00000000);
+  SetTriad(&connections[1], 0x0000, 0x0000, 0x00000001);
+  AddNewActiveConnection(&connections[0]);
+  AddNewActiveConnection(&connections[1]);
+  RemoveFromActiveConnections(&connections[0]);
+  ConnectionObjectInitializeEmpty(&connections[0]);
+  SetTriad(&connections[2], 0x0001, 0x0000, 0x00000000);
+  POINTERS_EQUAL( NULL, CheckForExistingConnection(&connections[2]) );
+  POINTERS_EQUAL( &connections[1],
+                  CheckForExistingConnection(&connections[1]) );
+}
+
+TEST(CipConnectionManager, TimedOutConnectionIsNoExistingConnection) {
+  SetTriad(&connections[0], 0x1234, 0x0001, 0xCAFE0000);
+  AddNewActiveConnection(&connections[0]);
+  ConnectionObjectSetState(&connections[0], kConnectionObjectStateTimedOut);
+  POINTERS_EQUAL( NULL, CheckForExistingConnection(&connections[0]) );
+}
+
+TEST(CipConnectionManager, ConnectionIsFoundByConsumedConnectionId) {
+  AddNewActiveConnection(&connections[0]);
+  AddNewActiveConnection(&connections[1]);
+  POINTERS_EQUAL( &connections[1], GetConnectedObject(0x101) );
+  POINTERS_EQUAL( NULL, GetConnectedObject(0x102) );
+}
+
+
+TEST(CipConnectionManager, ProductionsWithEqualRpiAreSpread) {
+  for(size_t i = 0; i < 3; ++i) {
+    SetProducing(&connections[i], 10000);
+    connections[i].produced_path.instance_id = 100 + i;
+    AddNewActiveConnection(&connections[i]);
+  }
+  /* the first connection produces right away, the others fill the gaps */
+  CHECK_EQUAL( GetConnectionManagerTime(),
+               connections[0].transmission_trigger_timer.deadline );
+  CHECK_EQUAL( (GetPhase(&connections[0]) + 5000) % 10000,
+               GetPhase(&connections[1]) );
+  CHECK_EQUAL( (GetPhase(&connections[1]) + 2500) % 10000,
+               GetPhase(&connections[2]) );
+}
+
+TEST(CipConnectionManager, ProductionsOfSameAssemblyShareThePhase) {
+  SetProducing(&connections[0], 10000);
+  connections[0].produced_path.instance_id = 100;
+  AddNewActiveConnection(&connections[0]);
+  SetProducing(&connections[1], 10000);
+  connections[1].produced_path.instance_id = 101;
+  AddNewActiveConnection(&connections[1]);
+  SetProducing(&connections[2], 10000);
+  connections[2].produced_path.instance_id = 100;
+  AddNewActiveConnection(&connections[2]);
+  CHECK_EQUAL( GetPhase(&connections[0]), GetPhase(&connections[2]) );
+}
+
+TEST(CipConnectionManager, ConsumersOfAssemblyAreServedFromOneSnapshot) {
+  EipUint8 assembly_data[4] = {1, 2, 3, 4};
+  CipByteArray byte_array = {sizeof(assembly_data), assembly_data};
+  CipAttributeStruct attribute = {};
+  attribute.data = &byte_array;
+  CipInstance instance = {};
+  instance.attributes = &attribute;
+  MessageBufferPool pool;
+  MessageBufferPoolInitialize(&pool, calloc, free);
+  for(size_t i = 0; i < 2; ++i) {
+    SetIoConnection(&connections[i], kConnectionObjectInstanceTypeIOInputOnly,
+                    254, 100);
+    SetProducing(&connections[i], 10000);
+    connections[i].producing_instance = &instance;
+    connections[i].produced_data_buffer =
+      MessageBufferPoolAcquire( &pool, sizeof(assembly_data) );
+    connections[i].connection_send_data_function = SendConnectedData;
+    AddNewActiveConnection(&connections[i]);
+  }
+  /* both consumers are produced in the same cycles, notifying once per RPI */
+  mock().expectNCalls(2, "BeforeAssemblyDataSend");
+  const MicroSeconds start = GetConnectionManagerTime();
+  for(MicroSeconds time = start; time <= start + 10000; time += 2500) {
+    ManageConnectionTimers(time);
+  }
+  MessageBufferPoolDestroy(&pool);
+}
+
+TEST(CipConnectionManager, ProductionsWithOtherRpiAreNotSpread) {
+  SetProducing(&connections[0], 10000);
+  SetProducing(&connections[1], 20000);
+  AddNewActiveConnection(&connections[0]);
+  AddNewActiveConnection(&connections[1]);
+  CHECK_EQUAL( GetConnectionManagerTime(),
+               connections[1].transmission_trigger_timer.deadline );
+}
+
+TEST(CipConnectionManager, ConfiguredProductionPhaseIsUsed) {
+  ConfigureExclusiveOwnerConnectionPoint(0, 150, 100, 151);
+  CHECK_EQUAL( kEipStatusOk, ConfigureProductionPhase(100, 250) );
+  CHECK_EQUAL( kEipStatusError, ConfigureProductionPhase(100, 1000) );
+  CHECK_EQUAL( kEipStatusError, ConfigureProductionPhase(101, 0) );
+  SetProducing(&connections[0], 10000);
+  connections[0].produced_path.instance_id = 100;
+  AddNewActiveConnection(&connections[0]);
+  CHECK_EQUAL( 2500, GetPhase(&connections[0]) );
+  CHECK( GetConnectionManagerTime() <=
+         connections[0].transmission_trigger_timer.deadline );
+  CHECK( GetConnectionManagerTime() + 10000 >
+         connections[0].transmission_trigger_timer.deadline );
+}
+
+TEST(CipConnectionManager, TriggeredConnectionIsProducedRightAway) {
+  SetTriggered(&connections[0], 0x20);
+  AddNewActiveConnection(&connections[0]);
+  CHECK_EQUAL( kEipStatusOk, TriggerConnections(150, 100) );
+  CHECK_EQUAL(1, s_productions);
+  /* the next production without a trigger follows one RPI later */
+  CHECK_EQUAL( GetConnectionManagerTime() + 10000,
+               connections[0].transmission_trigger_timer.deadline );
+}
+
+TEST(CipConnectionManager, ExplicitConnectionIsNotFoundByAssembly) {
+  SetTriggered(&connections[0], 0x20);
+  ConnectionObjectSetInstanceType(&connections[0],
+                                  kConnectionObjectInstanceTypeExplicitMessaging);
+  CHECK_EQUAL( kEipStatusOk, AddNewActiveConnection(&connections[0]) );
+  CHECK_EQUAL( kEipStatusError, TriggerConnections(150, 100) );
+  CHECK_EQUAL(0, s_productions);
+}
+
+TEST(CipConnectionManager, InhibitedTriggerIsProducedAfterInhibitTime) {
+  SetTriggered(&connections[0], 0x10);
+  connections[0].production_inhibit_time = 5;
+  AddNewActiveConnection(&connections[0]);
+  CHECK_EQUAL( kEipStatusOk, TriggerConnections(150, 100) );
+  CHECK_EQUAL( kEipStatusOk, TriggerConnections(150, 100) );
+  CHECK_EQUAL(1, s_productions);
+  CHECK_EQUAL( GetConnectionManagerTime() + 5000,
+               connections[0].transmission_trigger_timer.deadline );
+}
+
+TEST(CipConnectionManager, CyclicConnectionIsNotTriggered) {
+  SetTriggered(&connections[0], 0x00);
+  AddNewActiveConnection(&connections[0]);
+  CHECK_EQUAL( kEipStatusError, TriggerConnections(150, 100) );
+  CHECK_EQUAL(0, s_productions);
+}
+
+TEST(CipConnectionManager, ConnectionsAreFoundByAssembly) {
+  SetIoConnection(&connections[0], kConnectionObjectInstanceTypeIOExclusiveOwner,
+                  150, 100);
+  SetIoConnection(&connections[1], kConnectionObjectInstanceTypeIOInputOnly,
+                  152, 100);
+  AddNewActiveConnection(&connections[0]);
+  AddNewActiveConnection(&connections[1]);
+  POINTERS_EQUAL( &connections[0], GetConnectedOutputAssembly(100) );
+  CHECK( IsConnectedOutputAssembly(150) );
+  CHECK( IsConnectedOutputAssembly(152) );
+  CHECK_FALSE( IsConnectedOutputAssembly(100) );
+  RemoveFromActiveConnections(&connections[0]);
+  ConnectionObjectInitializeEmpty(&connections[0]);
+  POINTERS_EQUAL( NULL, GetConnectedOutputAssembly(100) );
+  CHECK_FALSE( IsConnectedOutputAssembly(150) );
+}
+
+TEST(CipConnectionManager, ConnectionsOfInputWithSameTypeAreClosed) {
+  SetIoConnection(&connections[0], kConnectionObjectInstanceTypeIOListenOnly,
+                  153, 100);
+  SetIoConnection(&connections[1], kConnectionObjectInstanceTypeIOInputOnly,
+                  152, 100);
+  SetIoConnection(&connections[2], kConnectionObjectInstanceTypeIOListenOnly,
+                  153, 100);
+  for(size_t i = 0; i < 3; ++i) {
+    SetTriad(&connections[i], (EipUint16) i, 0x0001, 0xCAFE0000);
+    AddNewActiveConnection(&connections[i]);
+  }
+  CloseAllConnectionsForInputWithSameType(100,
+                                          kConnectionObjectInstanceTypeIOListenOnly);
+  CHECK_EQUAL( kConnectionObjectStateNonExistent,
+               ConnectionObjectGetState(&connections[0]) );
+  CHECK_EQUAL( kConnectionObjectStateEstablished,
+               ConnectionObjectGetState(&connections[1]) );
+  CHECK_EQUAL( kConnectionObjectStateNonExistent,
+               ConnectionObjectGetState(&connections[2]) );
+}
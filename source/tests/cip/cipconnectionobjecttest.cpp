@@ -5,6 +5,7 @@
  ******************************************************************************/
 
 #include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -368,6 +369,16 @@ TEST(CipConnectionObject, ExpectedPacketRateZero) {
   CHECK_EQUAL(0, expected_packet_rate);
 }
 
+TEST(CipConnectionObject, RequestedPacketIntervalRoundedDownToTimerResolution) {
+  CipConnectionObject connection_object = {0};
+  connection_object.t_to_o_requested_packet_interval =
+    OPENER_CONNECTION_TIMER_RESOLUTION_IN_MICROSECONDS * 3 / 2;
+  CipUdint requested_packet_interval =
+    ConnectionObjectGetRequestedPacketInterval(&connection_object);
+  CHECK_EQUAL(OPENER_CONNECTION_TIMER_RESOLUTION_IN_MICROSECONDS,
+              requested_packet_interval);
+}
+
 TEST(CipConnectionObject, ParseConnectionData) {
   CipConnectionObject connection_object = {0};
   const CipOctet message[] =
@@ -469,3 +480,22 @@ TEST(CipConnectionObject, ParseConnectionData) {
               transport_class);
 
 }
+
+TEST(CipConnectionObject, ListNodesAreTakenFromPool) {
+  mock().ignoreOtherCalls(); /* the pool is allocated with CipCalloc */
+  CHECK_EQUAL( kEipStatusOk, CipConnectionObjectListArrayInitialize(2) );
+  DoublyLinkedListNode *first = CipConnectionObjectListArrayAllocator();
+  DoublyLinkedListNode *second = CipConnectionObjectListArrayAllocator();
+  CHECK(NULL != first);
+  CHECK(NULL != second);
+  CHECK(first != second);
+  POINTERS_EQUAL( NULL, CipConnectionObjectListArrayAllocator() );
+
+  CipConnectionObjectListArrayFree(&first);
+  POINTERS_EQUAL(NULL, first);
+  DoublyLinkedListNode *reused = CipConnectionObjectListArrayAllocator();
+  CHECK(NULL != reused);
+  POINTERS_EQUAL(NULL, reused->next);
+  POINTERS_EQUAL( NULL, CipConnectionObjectListArrayAllocator() );
+  CipConnectionObjectListArrayShutdown();
+}
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+extern "C" {
+
+#include "io_socket_filter.h"
+
+}
+
+/* Attaches the filter to a loopback UDP socket and checks which datagrams
+ * are received */
+TEST_GROUP(IoSocketFilter) {
+  IoSocketFilter filter;
+  int receiver;
+  int sender;
+  struct sockaddr_in receiver_address;
+
+  void setup() {
+    IoSocketFilterClear(&filter);
+    receiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    memset(&receiver_address, 0, sizeof(receiver_address) );
+    receiver_address.sin_family = AF_INET;
+    receiver_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    CHECK_EQUAL( 0, bind(receiver, (struct sockaddr *) &receiver_address,
+                         sizeof(receiver_address) ) );
+    socklen_t address_length = sizeof(receiver_address);
+    getsockname(receiver, (struct sockaddr *) &receiver_address,
+                &address_length);
+  }
+
+  void teardown() {
+    close(receiver);
+    close(sender);
+  }
+
+  /* Sends connected data with a sequenced address item and checks if it
+   * passed the filter */
+  bool IsReceived(const CipUdint connection_id) {
+    const uint8_t datagram[] = {
+      0x02, 0x00, /* item count */
+      0x02, 0x80, 0x08, 0x00, /* sequenced address item */
+      (uint8_t) connection_id, (uint8_t) (connection_id >> 8),
+      (uint8_t) (connection_id >> 16), (uint8_t) (connection_id >> 24),
+      0x01, 0x00, 0x00, 0x00, /* sequence number */
+      0xB1, 0x00, 0x02, 0x00, 0x01, 0x00 /* connected data item */
+    };
+    sendto(sender, datagram, sizeof(datagram), 0,
+           (struct sockaddr *) &receiver_address, sizeof(receiver_address) );
+    uint8_t buffer[64];
+    return 0 < recv(receiver, buffer, sizeof(buffer), MSG_DONTWAIT);
+  }
+};
+
+TEST(IoSocketFilter, EmptyFilterDropsAll) {
+  CHECK_EQUAL( kEipStatusOk, IoSocketFilterAttach(&filter, receiver) );
+  CHECK_FALSE( IsReceived(0x12345678) );
+}
+
+TEST(IoSocketFilter, ConnectionOfOriginatorPasses) {
+  IoSocketFilterAddConnection(&filter, 0x12345678, htonl(INADDR_LOOPBACK) );
+  CHECK_EQUAL( kEipStatusOk, IoSocketFilterAttach(&filter, receiver) );
+  CHECK( IsReceived(0x12345678) );
+  CHECK_FALSE( IsReceived(0x12345679) );
+  CHECK_FALSE( IsReceived(0x78563412) );
+}
+
+TEST(IoSocketFilter, ConnectionOfOtherOriginatorIsDropped) {
+  IoSocketFilterAddConnection(&filter, 0x12345678, inet_addr("127.0.0.2") );
+  CHECK_EQUAL( kEipStatusOk, IoSocketFilterAttach(&filter, receiver) );
+  CHECK_FALSE( IsReceived(0x12345678) );
+}
+
+TEST(IoSocketFilter, SameConnectionIdOfTwoOriginators) {
+  IoSocketFilterAddConnection(&filter, 0x12345678, inet_addr("127.0.0.2") );
+  IoSocketFilterAddConnection(&filter, 0x00000001, htonl(INADDR_LOOPBACK) );
+  IoSocketFilterAddConnection(&filter, 0x12345678, htonl(INADDR_LOOPBACK) );
+  CHECK_EQUAL( kEipStatusOk, IoSocketFilterAttach(&filter, receiver) );
+  CHECK( IsReceived(0x12345678) );
+  CHECK( IsReceived(0x00000001) );
+}
+
+TEST(IoSocketFilter, ConnectionOfAnyOriginatorPasses) {
+  IoSocketFilterAddConnection(&filter, 0x12345678, htonl(INADDR_ANY) );
+  CHECK_EQUAL( kEipStatusOk, IoSocketFilterAttach(&filter, receiver) );
+  CHECK( IsReceived(0x12345678) );
+  CHECK_FALSE( IsReceived(0x12345679) );
+}
+
+TEST(IoSocketFilter, TooManyConnectionsPassAll) {
+  for(CipUdint i = 0; i <= OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS; i++) {
+    IoSocketFilterAddConnection(&filter, i, htonl(INADDR_LOOPBACK) );
+  }
+  CHECK_EQUAL( kEipStatusOk, IoSocketFilterAttach(&filter, receiver) );
+  CHECK( IsReceived(0x12345678) );
+}
+
+TEST(IoSocketFilter, FullFilterChecksLastConnection) {
+  for(CipUdint i = 0; i < OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS; i++) {
+    IoSocketFilterAddConnection(&filter, i, htonl(INADDR_LOOPBACK) );
+  }
+  CHECK_EQUAL( kEipStatusOk, IoSocketFilterAttach(&filter, receiver) );
+  CHECK( IsReceived(OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS - 1) );
+  CHECK_FALSE( IsReceived(OPENER_IO_SOCKET_FILTER_MAX_CONNECTIONS) );
+}
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+extern "C" {
+
+#include "io_timestamping.h"
+#include "networkhandler.h"
+
+}
+
+/* Sends datagrams over loopback, which generates software timestamps */
+TEST_GROUP(IoTimestamping) {
+  int receiver;
+  int sender;
+  struct sockaddr_in receiver_address;
+
+  void setup() {
+    IoTimestampingInitialize();
+    receiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    memset(&receiver_address, 0, sizeof(receiver_address) );
+    receiver_address.sin_family = AF_INET;
+    receiver_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    CHECK_EQUAL( 0, bind(receiver, (struct sockaddr *) &receiver_address,
+                         sizeof(receiver_address) ) );
+    socklen_t address_length = sizeof(receiver_address);
+    getsockname(receiver, (struct sockaddr *) &receiver_address,
+                &address_length);
+  }
+
+  void teardown() {
+    IoTimestampingDisable(receiver);
+    IoTimestampingDisable(sender);
+    close(receiver);
+    close(sender);
+  }
+
+  void Send(void) {
+    const char datagram[] = "data";
+    CHECK( 0 < sendto(sender, datagram, sizeof(datagram), 0,
+                      (struct sockaddr *) &receiver_address,
+                      sizeof(receiver_address) ) );
+  }
+};
+
+TEST(IoTimestamping, NotedDatagramGetsTransmitTime) {
+  CHECK_EQUAL( kEipStatusOk, IoTimestampingEnable(sender) );
+  const MicroSeconds send_time = GetMicroSeconds();
+  IoTimestampingNoteSent(sender, 0x12345678, send_time - 100);
+  Send();
+
+  CipUdint connection_id = 0;
+  MicroSeconds production_deadline = 0;
+  MicroSeconds transmit_time = 0;
+  CHECK( IoTimestampingReceiveTransmitted(&connection_id,
+                                          &production_deadline,
+                                          &transmit_time) );
+  UNSIGNED_LONGS_EQUAL( 0x12345678, connection_id );
+  CHECK( send_time - 100 == production_deadline );
+  /* the clocks are converted with microsecond resolution */
+  CHECK( transmit_time + 1 >= send_time );
+  CHECK( transmit_time <= GetMicroSeconds() + 1 );
+  CHECK_FALSE( IoTimestampingReceiveTransmitted(&connection_id,
+                                                &production_deadline,
+                                                &transmit_time) );
+}
+
+TEST(IoTimestamping, DatagramsAreMatchedInOrder) {
+  CHECK_EQUAL( kEipStatusOk, IoTimestampingEnable(sender) );
+  IoTimestampingNoteSent(sender, 1, 10);
+  Send();
+  IoTimestampingNoteSent(sender, 2, 20);
+  Send();
+
+  CipUdint connection_id = 0;
+  MicroSeconds production_deadline = 0;
+  MicroSeconds transmit_time = 0;
+  CHECK( IoTimestampingReceiveTransmitted(&connection_id,
+                                          &production_deadline,
+                                          &transmit_time) );
+  UNSIGNED_LONGS_EQUAL( 1, connection_id );
+  CHECK( IoTimestampingReceiveTransmitted(&connection_id,
+                                          &production_deadline,
+                                          &transmit_time) );
+  UNSIGNED_LONGS_EQUAL( 2, connection_id );
+  CHECK( 20 == production_deadline );
+}
+
+TEST(IoTimestamping, UnnotedSocketIsNotRead) {
+  CHECK_EQUAL( kEipStatusOk, IoTimestampingEnable(sender) );
+  Send();
+
+  CipUdint connection_id = 0;
+  MicroSeconds production_deadline = 0;
+  MicroSeconds transmit_time = 0;
+  CHECK_FALSE( IoTimestampingReceiveTransmitted(&connection_id,
+                                                &production_deadline,
+                                                &transmit_time) );
+}
+
+TEST(IoTimestamping, DisabledSocketIsForgotten) {
+  CHECK_EQUAL( kEipStatusOk, IoTimestampingEnable(sender) );
+  IoTimestampingNoteSent(sender, 1, 10);
+  Send();
+  IoTimestampingDisable(sender);
+
+  CipUdint connection_id = 0;
+  MicroSeconds production_deadline = 0;
+  MicroSeconds transmit_time = 0;
+  CHECK_FALSE( IoTimestampingReceiveTransmitted(&connection_id,
+                                                &production_deadline,
+                                                &transmit_time) );
+}
+
+TEST(IoTimestamping, ReceivedDatagramHasReceiveTime) {
+  CHECK_EQUAL( kEipStatusOk, IoTimestampingEnable(receiver) );
+  const MicroSeconds send_time = GetMicroSeconds();
+  Send();
+
+  char buffer[16];
+  char control[IO_TIMESTAMPING_CONTROL_SIZE];
+  struct iovec io_vector = { buffer, sizeof(buffer) };
+  struct msghdr message;
+  memset( &message, 0, sizeof(message) );
+  message.msg_iov = &io_vector;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  CHECK( 0 < recvmsg(receiver, &message, MSG_DONTWAIT) );
+
+  const MicroSeconds receive_time = IoTimestampingGetReceiveTime(&message);
+  CHECK( receive_time + 1 >= send_time );
+  CHECK( receive_time <= GetMicroSeconds() + 1 );
+}
+
+TEST(IoTimestamping, DatagramWithoutTimestampHasNoReceiveTime) {
+  Send();
+
+  char buffer[16];
+  char control[IO_TIMESTAMPING_CONTROL_SIZE];
+  struct iovec io_vector = { buffer, sizeof(buffer) };
+  struct msghdr message;
+  memset( &message, 0, sizeof(message) );
+  message.msg_iov = &io_vector;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+  CHECK( 0 < recvmsg(receiver, &message, MSG_DONTWAIT) );
+
+  CHECK( 0 == IoTimestampingGetReceiveTime(&message) );
+}
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+extern "C" {
+
+#include "network_event.h"
+
+}
+
+/* Runs against the network event backend selected for the build */
+TEST_GROUP(NetworkEvent) {
+  int receiver;
+  int sender;
+  struct sockaddr_in receiver_address;
+  NetworkEvent events[4];
+
+  void setup() {
+    CHECK_EQUAL( kEipStatusOk, NetworkEventInitialize() );
+    receiver = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sender = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    memset(&receiver_address, 0, sizeof(receiver_address) );
+    receiver_address.sin_family = AF_INET;
+    receiver_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    CHECK_EQUAL( 0, bind(receiver, (struct sockaddr *) &receiver_address,
+                         sizeof(receiver_address) ) );
+    socklen_t address_length = sizeof(receiver_address);
+    getsockname(receiver, (struct sockaddr *) &receiver_address,
+                &address_length);
+  }
+
+  void teardown() {
+    NetworkEventRemoveSocket(receiver);
+    close(receiver);
+    close(sender);
+    NetworkEventFinish();
+  }
+
+  void Send(void) {
+    const char datagram[] = "ping";
+    sendto(sender, datagram, sizeof(datagram), 0,
+           (struct sockaddr *) &receiver_address, sizeof(receiver_address) );
+  }
+};
+
+TEST(NetworkEvent, TimeoutWithoutData) {
+  CHECK_EQUAL( kEipStatusOk,
+               NetworkEventAddSocket(receiver, kNetworkEventReadable) );
+  CHECK_EQUAL( 0, NetworkEventWait(1000, events, 4) );
+}
+
+TEST(NetworkEvent, ReadableSocketIsReported) {
+  CHECK_EQUAL( kEipStatusOk,
+               NetworkEventAddSocket(receiver, kNetworkEventReadable) );
+  Send();
+  CHECK_EQUAL( 1, NetworkEventWait(1000000, events, 4) );
+  CHECK_EQUAL(receiver, events[0].socket);
+  CHECK(events[0].events & kNetworkEventReadable);
+}
+
+TEST(NetworkEvent, StillReadableSocketIsReportedAgain) {
+  CHECK_EQUAL( kEipStatusOk,
+               NetworkEventAddSocket(receiver, kNetworkEventReadable) );
+  Send();
+  Send();
+  CHECK_EQUAL( 1, NetworkEventWait(1000000, events, 4) );
+  char buffer[16];
+  recv(receiver, buffer, sizeof(buffer), 0);
+  CHECK_EQUAL( 1, NetworkEventWait(1000000, events, 4) );
+  recv(receiver, buffer, sizeof(buffer), 0);
+  CHECK_EQUAL( 0, NetworkEventWait(1000, events, 4) );
+}
+
+TEST(NetworkEvent, RemovedSocketIsNotReported) {
+  CHECK_EQUAL( kEipStatusOk,
+               NetworkEventAddSocket(receiver, kNetworkEventReadable) );
+  NetworkEventRemoveSocket(receiver);
+  Send();
+  CHECK_EQUAL( 0, NetworkEventWait(1000, events, 4) );
+}
+
+TEST(NetworkEvent, ModifiedSocketIsReportedWritable) {
+  CHECK_EQUAL( kEipStatusOk,
+               NetworkEventAddSocket(receiver, kNetworkEventReadable) );
+  CHECK_EQUAL( kEipStatusOk,
+               NetworkEventModifySocket(receiver, kNetworkEventWritable) );
+  CHECK_EQUAL( 1, NetworkEventWait(1000000, events, 4) );
+  CHECK_EQUAL(receiver, events[0].socket);
+  CHECK_EQUAL(kNetworkEventWritable, events[0].events);
+  CHECK_EQUAL( kEipStatusOk,
+               NetworkEventModifySocket(receiver, kNetworkEventReadable) );
+  CHECK_EQUAL( 0, NetworkEventWait(1000, events, 4) );
+}
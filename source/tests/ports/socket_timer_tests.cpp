@@ -58,3 +58,50 @@ TEST(SocketTimer, ClearSocketTimer) {
   CHECK_EQUAL(-1, timer.socket);
   CHECK_EQUAL(0, timer.last_update);
 }
+
+TEST(SocketTimer, IndexGetsAddedSocketTimer) {
+  SocketTimer timers[3];
+  SocketTimer *slots[7];
+  SocketTimerIndex index;
+  SocketTimerArrayInitialize(timers, 3);
+  SocketTimerIndexInitialize(&index, slots, 7);
+  for(int i = 0; i < 3; i++) {
+    SocketTimerSetSocket(&timers[i], 10 + i);
+    CHECK_TRUE( SocketTimerIndexAdd(&index, &timers[i]) );
+  }
+  POINTERS_EQUAL( &timers[1], SocketTimerIndexGet(&index, 11) );
+  POINTERS_EQUAL( NULL, SocketTimerIndexGet(&index, 13) );
+}
+
+TEST(SocketTimer, IndexFindsAllSocketTimersAfterRemoval) {
+  SocketTimer timers[5];
+  SocketTimer *slots[5];
+  SocketTimerIndex index;
+  SocketTimerArrayInitialize(timers, 5);
+  SocketTimerIndexInitialize(&index, slots, 5);
+  /* a full index has colliding probe sequences */
+  for(int i = 0; i < 5; i++) {
+    SocketTimerSetSocket(&timers[i], 3 * i);
+    CHECK_TRUE( SocketTimerIndexAdd(&index, &timers[i]) );
+  }
+  POINTERS_EQUAL( &timers[2], SocketTimerIndexRemove(&index, 6) );
+  POINTERS_EQUAL( NULL, SocketTimerIndexRemove(&index, 6) );
+  for(int i = 0; i < 5; i++) {
+    if(2 != i) {
+      POINTERS_EQUAL( &timers[i], SocketTimerIndexGet(&index, 3 * i) );
+    }
+  }
+  POINTERS_EQUAL( NULL, SocketTimerIndexGet(&index, 6) );
+}
+
+TEST(SocketTimer, FullIndexRejectsSocketTimer) {
+  SocketTimer timers[2];
+  SocketTimer *slots[1];
+  SocketTimerIndex index;
+  SocketTimerArrayInitialize(timers, 2);
+  SocketTimerIndexInitialize(&index, slots, 1);
+  SocketTimerSetSocket(&timers[0], 1);
+  SocketTimerSetSocket(&timers[1], 2);
+  CHECK_TRUE( SocketTimerIndexAdd(&index, &timers[0]) );
+  CHECK_FALSE( SocketTimerIndexAdd(&index, &timers[1]) );
+}
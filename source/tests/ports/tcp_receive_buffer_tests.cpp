@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+
+#include "tcp_receive_buffer.h"
+#include "encap.h"
+
+}
+
+TEST_GROUP(TcpReceiveBuffer) {
+  TcpReceiveBuffer buffer;
+
+  void setup() {
+    TcpReceiveBufferSetSocket(&buffer, 5);
+  }
+
+  /* Appends an encapsulation message with the given amount of data */
+  void Append(const CipUint data_length,
+              const size_t number_of_bytes) {
+    CipOctet message[OPENER_TCP_RECEIVE_BUFFER_SIZE + 100] = { 0 };
+    message[2] = (CipOctet) (data_length & 0xFF);
+    message[3] = (CipOctet) (data_length >> 8);
+    size_t free_space = 0;
+    CipOctet *position = TcpReceiveBufferGetWritePosition(&buffer,
+                                                          &free_space);
+    CHECK(number_of_bytes <= free_space);
+    memcpy(position, message, number_of_bytes);
+    TcpReceiveBufferCommit(&buffer, number_of_bytes);
+  }
+};
+
+TEST(TcpReceiveBuffer, GetAvailableEmptyBuffer) {
+  TcpReceiveBuffer buffers[3];
+  TcpReceiveBufferArrayInitialize(buffers, 3);
+  TcpReceiveBufferSetSocket(&buffers[0], 7);
+  POINTERS_EQUAL( &buffers[1], TcpReceiveBufferArrayGetEmptyBuffer(buffers, 3) );
+  POINTERS_EQUAL( &buffers[0], TcpReceiveBufferArrayGetBuffer(buffers, 3, 7) );
+}
+
+TEST(TcpReceiveBuffer, ClearBuffer) {
+  Append(0, 10);
+  TcpReceiveBufferClear(&buffer);
+  CHECK_EQUAL(kEipInvalidSocket, buffer.socket);
+  CHECK_EQUAL(0, buffer.length);
+}
+
+TEST(TcpReceiveBuffer, IncompleteHeaderIsNoMessage) {
+  CipOctet *message = NULL;
+  Append(0, ENCAPSULATION_HEADER_LENGTH - 1);
+  CHECK_FALSE( TcpReceiveBufferHasMessage(&buffer) );
+  CHECK_EQUAL( 0, TcpReceiveBufferGetMessage(&buffer, &message, 512) );
+}
+
+TEST(TcpReceiveBuffer, HasMessageDoesNotConsume) {
+  CipOctet *message = NULL;
+  Append(10, ENCAPSULATION_HEADER_LENGTH + 4);
+  CHECK_FALSE( TcpReceiveBufferHasMessage(&buffer) );
+  size_t free_space = 0;
+  TcpReceiveBufferGetWritePosition(&buffer, &free_space);
+  TcpReceiveBufferCommit(&buffer, 6);
+  CHECK( TcpReceiveBufferHasMessage(&buffer) );
+  CHECK( TcpReceiveBufferHasMessage(&buffer) );
+  CHECK_EQUAL( ENCAPSULATION_HEADER_LENGTH + 10,
+               TcpReceiveBufferGetMessage(&buffer, &message, 512) );
+  TcpReceiveBufferConsume(&buffer, ENCAPSULATION_HEADER_LENGTH + 10);
+  CHECK_FALSE( TcpReceiveBufferHasMessage(&buffer) );
+}
+
+TEST(TcpReceiveBuffer, MessageCompletedBySecondRead) {
+  CipOctet *message = NULL;
+  Append(10, ENCAPSULATION_HEADER_LENGTH + 4);
+  CHECK_EQUAL( 0, TcpReceiveBufferGetMessage(&buffer, &message, 512) );
+  size_t free_space = 0;
+  TcpReceiveBufferGetWritePosition(&buffer, &free_space);
+  TcpReceiveBufferCommit(&buffer, 6);
+  CHECK_EQUAL( ENCAPSULATION_HEADER_LENGTH + 10,
+               TcpReceiveBufferGetMessage(&buffer, &message, 512) );
+  POINTERS_EQUAL(buffer.data, message);
+}
+
+TEST(TcpReceiveBuffer, PipelinedMessages) {
+  CipOctet *message = NULL;
+  Append(2, ENCAPSULATION_HEADER_LENGTH + 2);
+  Append(4, ENCAPSULATION_HEADER_LENGTH + 4);
+  CHECK_EQUAL( ENCAPSULATION_HEADER_LENGTH + 2,
+               TcpReceiveBufferGetMessage(&buffer, &message, 512) );
+  TcpReceiveBufferConsume(&buffer, ENCAPSULATION_HEADER_LENGTH + 2);
+  CHECK_EQUAL( ENCAPSULATION_HEADER_LENGTH + 4,
+               TcpReceiveBufferGetMessage(&buffer, &message, 512) );
+  POINTERS_EQUAL(&buffer.data[ENCAPSULATION_HEADER_LENGTH + 2], message);
+  TcpReceiveBufferConsume(&buffer, ENCAPSULATION_HEADER_LENGTH + 4);
+  CHECK_EQUAL(0, buffer.length);
+  CHECK_EQUAL(0, buffer.start);
+}
+
+TEST(TcpReceiveBuffer, IncompleteMessageIsMovedToFrontAtEnd) {
+  CipOctet *message = NULL;
+  const size_t first_size = OPENER_TCP_RECEIVE_BUFFER_SIZE - 10;
+  Append( (CipUint) (first_size - ENCAPSULATION_HEADER_LENGTH), first_size );
+  Append(0, 10);
+  CHECK_EQUAL( first_size, TcpReceiveBufferGetMessage(&buffer, &message, first_size) );
+  TcpReceiveBufferConsume(&buffer, first_size);
+  CHECK_EQUAL( 0, TcpReceiveBufferGetMessage(&buffer, &message, first_size) );
+
+  size_t free_space = 0;
+  CipOctet *position = TcpReceiveBufferGetWritePosition(&buffer, &free_space);
+  POINTERS_EQUAL(&buffer.data[10], position);
+  CHECK_EQUAL(OPENER_TCP_RECEIVE_BUFFER_SIZE - 10, free_space);
+  TcpReceiveBufferCommit(&buffer, ENCAPSULATION_HEADER_LENGTH - 10);
+  CHECK_EQUAL( ENCAPSULATION_HEADER_LENGTH,
+               TcpReceiveBufferGetMessage(&buffer, &message, first_size) );
+  POINTERS_EQUAL(buffer.data, message);
+}
+
+TEST(TcpReceiveBuffer, OversizedMessageIsDropped) {
+  CipOctet *message = NULL;
+  Append(100, ENCAPSULATION_HEADER_LENGTH + 50);
+  CHECK_EQUAL( 0, TcpReceiveBufferGetMessage(&buffer, &message, 64) );
+  CHECK_EQUAL(0, buffer.length);
+  /* the rest of the dropped message and a following valid message */
+  size_t free_space = 0;
+  TcpReceiveBufferGetWritePosition(&buffer, &free_space);
+  TcpReceiveBufferCommit(&buffer, 50);
+  Append(0, ENCAPSULATION_HEADER_LENGTH);
+  CHECK_EQUAL( ENCAPSULATION_HEADER_LENGTH,
+               TcpReceiveBufferGetMessage(&buffer, &message, 64) );
+  POINTERS_EQUAL(&buffer.data[50], message);
+}
@@ -0,0 +1,87 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+
+#include "tcp_send_queue.h"
+
+}
+
+TEST_GROUP(TcpSendQueue) {
+  TcpSendQueue queue;
+
+  void setup() {
+    TcpSendQueueSetSocket(&queue, 5);
+  }
+
+  /* Appends the given number of bytes counting up from first_value */
+  EipStatus Append(const size_t number_of_bytes,
+                   const CipOctet first_value) {
+    CipOctet data[OPENER_TCP_SEND_QUEUE_SIZE + 1];
+    for(size_t i = 0; i < number_of_bytes; i++) {
+      data[i] = (CipOctet) (first_value + i);
+    }
+    return TcpSendQueueAppend(&queue, data, number_of_bytes);
+  }
+};
+
+TEST(TcpSendQueue, GetQueueOfSocket) {
+  TcpSendQueue queues[3];
+  TcpSendQueueArrayInitialize(queues, 3);
+  TcpSendQueueSetSocket(&queues[0], 7);
+  POINTERS_EQUAL( &queues[1], TcpSendQueueArrayGetEmptyQueue(queues, 3) );
+  POINTERS_EQUAL( &queues[0], TcpSendQueueArrayGetQueue(queues, 3, 7) );
+}
+
+TEST(TcpSendQueue, NewQueueIsEmpty) {
+  CHECK_TRUE( TcpSendQueueIsEmpty(&queue) );
+  CHECK_TRUE( TcpSendQueueCanTakeMessage(&queue) );
+}
+
+TEST(TcpSendQueue, PartlySentDataKeepsOrder) {
+  CHECK_EQUAL( kEipStatusOk, Append(10, 0) );
+  CHECK_EQUAL( kEipStatusOk, Append(5, 10) );
+  TcpSendQueueConsume(&queue, 4);
+  size_t length = 0;
+  const CipOctet *data = TcpSendQueueGetData(&queue, &length);
+  CHECK_EQUAL(11, length);
+  for(size_t i = 0; i < length; i++) {
+    CHECK_EQUAL(4 + i, data[i]);
+  }
+}
+
+TEST(TcpSendQueue, UnsentDataIsMovedToFrontAtEnd) {
+  CHECK_EQUAL( kEipStatusOk, Append(OPENER_TCP_SEND_QUEUE_SIZE - 2, 0) );
+  TcpSendQueueConsume(&queue, OPENER_TCP_SEND_QUEUE_SIZE - 4);
+  CHECK_EQUAL( kEipStatusOk, Append(3, 100) );
+  size_t length = 0;
+  const CipOctet *data = TcpSendQueueGetData(&queue, &length);
+  POINTERS_EQUAL(queue.data, data);
+  CHECK_EQUAL(5, length);
+  CHECK_EQUAL(102, data[4]);
+}
+
+TEST(TcpSendQueue, OverflowIsRejected) {
+  CHECK_EQUAL( kEipStatusOk, Append(OPENER_TCP_SEND_QUEUE_SIZE - 1, 0) );
+  CHECK_EQUAL( kEipStatusError, Append(2, 0) );
+  CHECK_EQUAL( OPENER_TCP_SEND_QUEUE_SIZE - 1, queue.length );
+}
+
+TEST(TcpSendQueue, FullQueueCannotTakeMessage) {
+  CHECK_EQUAL( kEipStatusOk,
+               Append(OPENER_TCP_SEND_QUEUE_SIZE -
+                      PC_OPENER_ETHERNET_BUFFER_SIZE, 0) );
+  CHECK_TRUE( TcpSendQueueCanTakeMessage(&queue) );
+  CHECK_EQUAL( kEipStatusOk, Append(1, 0) );
+  CHECK_FALSE( TcpSendQueueCanTakeMessage(&queue) );
+  TcpSendQueueConsume(&queue, queue.length);
+  CHECK_TRUE( TcpSendQueueIsEmpty(&queue) );
+  CHECK_EQUAL(0, queue.start);
+}
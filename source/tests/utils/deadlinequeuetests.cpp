@@ -0,0 +1,93 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+#include <deadlinequeue.h>
+}
+
+TEST_GROUP(DeadlineQueue) {
+  static const size_t kCapacity = 8;
+
+  DeadlineQueueEntry *storage[kCapacity];
+  DeadlineQueueEntry entries[kCapacity];
+  DeadlineQueue queue;
+
+  void setup() {
+    DeadlineQueueInitialize(&queue, storage, kCapacity);
+    for(size_t i = 0; i < kCapacity; ++i) {
+      DeadlineQueueEntryInitialize(&entries[i], &entries[i]);
+    }
+  }
+};
+
+TEST(DeadlineQueue, EmptyQueue) {
+  POINTERS_EQUAL( NULL, DeadlineQueuePeek(&queue) );
+  POINTERS_EQUAL( NULL, DeadlineQueuePopExpired(&queue, UINT64_MAX) );
+  CHECK_FALSE( DeadlineQueueEntryIsQueued(&entries[0]) );
+}
+
+TEST(DeadlineQueue, PopInDeadlineOrder) {
+  const uint64_t deadlines[] = { 50, 10, 40, 10, 30, 20, 70, 60 };
+  for(size_t i = 0; i < kCapacity; ++i) {
+    CHECK_TRUE( DeadlineQueueSchedule(&queue, &entries[i], deadlines[i]) );
+  }
+  uint64_t previous_deadline = 0;
+  for(size_t i = 0; i < kCapacity; ++i) {
+    DeadlineQueueEntry *entry = DeadlineQueuePopExpired(&queue, UINT64_MAX);
+    CHECK(NULL != entry);
+    CHECK(previous_deadline <= entry->deadline);
+    CHECK_FALSE( DeadlineQueueEntryIsQueued(entry) );
+    previous_deadline = entry->deadline;
+  }
+  CHECK_EQUAL(0, queue.length);
+}
+
+TEST(DeadlineQueue, OnlyExpiredEntriesArePopped) {
+  DeadlineQueueSchedule(&queue, &entries[0], 100);
+  DeadlineQueueSchedule(&queue, &entries[1], 200);
+  POINTERS_EQUAL( NULL, DeadlineQueuePopExpired(&queue, 99) );
+  POINTERS_EQUAL( &entries[0], DeadlineQueuePopExpired(&queue, 100) );
+  POINTERS_EQUAL( NULL, DeadlineQueuePopExpired(&queue, 100) );
+  POINTERS_EQUAL( &entries[1], DeadlineQueuePeek(&queue) );
+}
+
+TEST(DeadlineQueue, RescheduleQueuedEntry) {
+  DeadlineQueueSchedule(&queue, &entries[0], 100);
+  DeadlineQueueSchedule(&queue, &entries[1], 200);
+  DeadlineQueueSchedule(&queue, &entries[2], 300);
+  DeadlineQueueSchedule(&queue, &entries[2], 50);
+  POINTERS_EQUAL( &entries[2], DeadlineQueuePeek(&queue) );
+  DeadlineQueueSchedule(&queue, &entries[2], 250);
+  POINTERS_EQUAL( &entries[0], DeadlineQueuePeek(&queue) );
+  CHECK_EQUAL(3, queue.length);
+}
+
+TEST(DeadlineQueue, CancelEntry) {
+  for(size_t i = 0; i < 5; ++i) {
+    DeadlineQueueSchedule(&queue, &entries[i], 10 * (i + 1) );
+  }
+  DeadlineQueueCancel(&queue, &entries[0]);
+  DeadlineQueueCancel(&queue, &entries[3]);
+  DeadlineQueueCancel(&queue, &entries[3]);
+  CHECK_FALSE( DeadlineQueueEntryIsQueued(&entries[3]) );
+  CHECK_EQUAL(3, queue.length);
+  POINTERS_EQUAL( &entries[1], DeadlineQueuePopExpired(&queue, UINT64_MAX) );
+  POINTERS_EQUAL( &entries[2], DeadlineQueuePopExpired(&queue, UINT64_MAX) );
+  POINTERS_EQUAL( &entries[4], DeadlineQueuePopExpired(&queue, UINT64_MAX) );
+}
+
+TEST(DeadlineQueue, FullQueueRejectsNewEntry) {
+  DeadlineQueueEntry *small_storage[1];
+  DeadlineQueueInitialize(&queue, small_storage, 1);
+  CHECK_TRUE( DeadlineQueueSchedule(&queue, &entries[0], 10) );
+  CHECK_FALSE( DeadlineQueueSchedule(&queue, &entries[1], 5) );
+  CHECK_TRUE( DeadlineQueueSchedule(&queue, &entries[0], 20) );
+  POINTERS_EQUAL( &entries[0], DeadlineQueuePeek(&queue) );
+}
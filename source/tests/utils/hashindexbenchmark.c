@@ -0,0 +1,79 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+/* Compares looking up the oldest of many objects in the hash index with
+ * walking a list, as the connection manager did for each received datagram.
+ * Only prints the times, it is not run as part of the unit tests. */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "hashindex.h"
+#include "doublylinkedlist.h"
+
+enum {
+  kObjects = 256,
+  kLookups = 200000
+};
+
+static HashIndexEntry s_storage[2 * kObjects];
+static uint32_t s_keys[kObjects];
+static DoublyLinkedListNode s_nodes[kObjects];
+
+static double GetSeconds(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double) now.tv_sec + (double) now.tv_nsec / 1e9;
+}
+
+int main(void) {
+  HashIndex index;
+  DoublyLinkedListNode *first = NULL;
+
+  HashIndexInitialize(&index, s_storage, 2 * kObjects);
+  for(size_t i = 0; i < kObjects; ++i) {
+    s_keys[i] = 0x20000 + (uint32_t) i;
+    HashIndexInsert(&index, s_keys[i], &s_keys[i]);
+    s_nodes[i].data = &s_keys[i];
+    s_nodes[i].next = first;
+    first = &s_nodes[i];
+  }
+
+  /* read on every lookup, so the lookups cannot be hoisted out of the loops */
+  volatile uint32_t key = s_keys[0];
+  void *volatile found = NULL;
+
+  double start = GetSeconds();
+  for(size_t i = 0; i < kLookups; ++i) {
+    const uint32_t wanted = key;
+    for(DoublyLinkedListNode *node = first; NULL != node;
+        node = node->next) {
+      if(wanted == *(uint32_t *) node->data) {
+        found = node->data;
+        break;
+      }
+    }
+  }
+  const double scan_time = GetSeconds() - start;
+  if(&s_keys[0] != found) {
+    return 1;
+  }
+
+  found = NULL;
+  start = GetSeconds();
+  for(size_t i = 0; i < kLookups; ++i) {
+    found = HashIndexFind(&index, key, NULL, NULL);
+  }
+  const double index_time = GetSeconds() - start;
+  if(&s_keys[0] != found) {
+    return 1;
+  }
+
+  printf("%d lookups among %d objects: list scan %.3f ms, hash index %.3f ms\n",
+         kLookups, kObjects, scan_time * 1e3, index_time * 1e3);
+  return 0;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+#include <hashindex.h>
+}
+
+static bool IsOdd(const void *const data, const void *const context) {
+  (void) context;
+  return 0 != (*(const uint32_t *) data & 1U);
+}
+
+static bool IsEqual(const void *const data, const void *const context) {
+  return *(const uint32_t *) data == *(const uint32_t *) context;
+}
+
+TEST_GROUP(HashIndex) {
+  static const size_t kCapacity = 16;
+
+  HashIndexEntry storage[kCapacity];
+  uint32_t objects[kCapacity];
+  HashIndex index;
+
+  void setup() {
+    HashIndexInitialize(&index, storage, kCapacity);
+    for(size_t i = 0; i < kCapacity; ++i) {
+      objects[i] = (uint32_t) i;
+    }
+  }
+};
+
+TEST(HashIndex, EmptyIndex) {
+  CHECK_EQUAL(0, index.length);
+  POINTERS_EQUAL( NULL, HashIndexFind(&index, 0, NULL, NULL) );
+  CHECK_FALSE( HashIndexRemove(&index, 0, &objects[0]) );
+}
+
+TEST(HashIndex, CapacityIsRoundedDownToPowerOfTwo) {
+  HashIndexInitialize(&index, storage, 12);
+  CHECK_EQUAL(8, index.capacity);
+}
+
+TEST(HashIndex, FindInsertedObjects) {
+  for(size_t i = 0; i < kCapacity / 2; ++i) {
+    CHECK_TRUE( HashIndexInsert(&index, 0x10000 + i, &objects[i]) );
+  }
+  for(size_t i = 0; i < kCapacity / 2; ++i) {
+    POINTERS_EQUAL( &objects[i],
+                    HashIndexFind(&index, 0x10000 + i, NULL, NULL) );
+  }
+  POINTERS_EQUAL( NULL, HashIndexFind(&index, 0x20000, NULL, NULL) );
+}
+
+TEST(HashIndex, OneSlotIsKeptFree) {
+  for(size_t i = 0; i < kCapacity - 1; ++i) {
+    CHECK_TRUE( HashIndexInsert(&index, i, &objects[i]) );
+  }
+  CHECK_FALSE( HashIndexInsert(&index, kCapacity, &objects[0]) );
+  POINTERS_EQUAL( NULL, HashIndexFind(&index, kCapacity, NULL, NULL) );
+}
+
+TEST(HashIndex, AcceptSelectsAmongSameKey) {
+  HashIndexInsert(&index, 42, &objects[2]);
+  HashIndexInsert(&index, 42, &objects[3]);
+  HashIndexInsert(&index, 42, &objects[4]);
+  POINTERS_EQUAL( &objects[3], HashIndexFind(&index, 42, IsOdd, NULL) );
+  HashIndexRemove(&index, 42, &objects[3]);
+  POINTERS_EQUAL( NULL, HashIndexFind(&index, 42, IsOdd, NULL) );
+  CHECK( NULL != HashIndexFind(&index, 42, NULL, NULL) );
+}
+
+TEST(HashIndex, ContextSelectsAmongSameKey) {
+  HashIndexInsert(&index, 42, &objects[2]);
+  HashIndexInsert(&index, 42, &objects[3]);
+  const uint32_t wanted = 3;
+  const uint32_t missing = 4;
+  POINTERS_EQUAL( &objects[3], HashIndexFind(&index, 42, IsEqual, &wanted) );
+  POINTERS_EQUAL( NULL, HashIndexFind(&index, 42, IsEqual, &missing) );
+}
+
+TEST(HashIndex, RemoveKeepsCollidingObjectsReachable) {
+  /* fills the index up to the free slot, so all probe sequences collide */
+  for(size_t i = 0; i < kCapacity - 1; ++i) {
+    HashIndexInsert(&index, i * 7, &objects[i]);
+  }
+  for(size_t i = 0; i < kCapacity - 1; i += 2) {
+    CHECK_TRUE( HashIndexRemove(&index, i * 7, &objects[i]) );
+  }
+  for(size_t i = 0; i < kCapacity - 1; ++i) {
+    POINTERS_EQUAL( (i % 2) ? &objects[i] : NULL,
+                    HashIndexFind(&index, i * 7, NULL, NULL) );
+  }
+  CHECK_EQUAL(kCapacity / 2 - 1, index.length);
+}
+
+TEST(HashIndex, RemoveNeedsKeyAndObject) {
+  HashIndexInsert(&index, 1, &objects[1]);
+  CHECK_FALSE( HashIndexRemove(&index, 1, &objects[2]) );
+  CHECK_FALSE( HashIndexRemove(&index, 2, &objects[1]) );
+  CHECK_TRUE( HashIndexRemove(&index, 1, &objects[1]) );
+  CHECK_EQUAL(0, index.length);
+}
+
+/* Looks up the oldest of many objects, which a list scan finds last, the
+ * timing comparison with the scan is done by HashIndexBenchmark */
+TEST(HashIndex, OldestOfManyObjectsIsFound) {
+  enum {
+    kObjects = 256
+  };
+  static HashIndexEntry large_storage[2 * kObjects];
+  static uint32_t keys[kObjects];
+
+  HashIndexInitialize(&index, large_storage, 2 * kObjects);
+  for(size_t i = 0; i < kObjects; ++i) {
+    keys[i] = 0x20000 + (uint32_t) i;
+    CHECK_TRUE( HashIndexInsert(&index, keys[i], &keys[i]) );
+  }
+  for(size_t i = 0; i < kObjects; ++i) {
+    POINTERS_EQUAL( &keys[i], HashIndexFind(&index, keys[i], NULL, NULL) );
+  }
+  POINTERS_EQUAL( NULL, HashIndexFind(&index, 0x20000 + kObjects, NULL,
+                                      NULL) );
+}
@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+#include <latencyhistogram.h>
+}
+
+TEST_GROUP(LatencyHistogram) {
+  LatencyHistogram histogram;
+
+  void setup() {
+    LatencyHistogramInitialize(&histogram);
+  }
+};
+
+TEST(LatencyHistogram, EmptyHistogram) {
+  UNSIGNED_LONGS_EQUAL( 0, histogram.count );
+  UNSIGNED_LONGS_EQUAL( 0, LatencyHistogramGetMean(&histogram) );
+  UNSIGNED_LONGS_EQUAL( 0, LatencyHistogramGetPercentile(&histogram, 99) );
+}
+
+TEST(LatencyHistogram, BucketsArePowersOfTwo) {
+  UNSIGNED_LONGS_EQUAL( 0, LatencyHistogramGetBucket(0) );
+  UNSIGNED_LONGS_EQUAL( 1, LatencyHistogramGetBucket(1) );
+  UNSIGNED_LONGS_EQUAL( 2, LatencyHistogramGetBucket(2) );
+  UNSIGNED_LONGS_EQUAL( 2, LatencyHistogramGetBucket(3) );
+  UNSIGNED_LONGS_EQUAL( 3, LatencyHistogramGetBucket(4) );
+  UNSIGNED_LONGS_EQUAL( 10, LatencyHistogramGetBucket(1000) );
+}
+
+TEST(LatencyHistogram, LargeLatenciesGoToTheLastBucket) {
+  UNSIGNED_LONGS_EQUAL( LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1,
+                        LatencyHistogramGetBucket(1ULL << 14) );
+  UNSIGNED_LONGS_EQUAL( LATENCY_HISTOGRAM_NUMBER_OF_BUCKETS - 1,
+                        LatencyHistogramGetBucket(UINT64_MAX) );
+}
+
+TEST(LatencyHistogram, AddUpdatesStatistics) {
+  LatencyHistogramAdd(&histogram, 10);
+  LatencyHistogramAdd(&histogram, 30);
+  LatencyHistogramAdd(&histogram, 20);
+  UNSIGNED_LONGS_EQUAL( 3, histogram.count );
+  UNSIGNED_LONGS_EQUAL( 60, histogram.sum );
+  UNSIGNED_LONGS_EQUAL( 30, histogram.max );
+  UNSIGNED_LONGS_EQUAL( 20, LatencyHistogramGetMean(&histogram) );
+  UNSIGNED_LONGS_EQUAL( 2, histogram.buckets[LatencyHistogramGetBucket(20)] );
+}
+
+TEST(LatencyHistogram, PercentileIsUpperBoundOfItsBucket) {
+  for(int i = 0; i < 99; ++i) {
+    LatencyHistogramAdd(&histogram, 5);
+  }
+  LatencyHistogramAdd(&histogram, 1000);
+  UNSIGNED_LONGS_EQUAL( 7, LatencyHistogramGetPercentile(&histogram, 50) );
+  UNSIGNED_LONGS_EQUAL( 7, LatencyHistogramGetPercentile(&histogram, 99) );
+  UNSIGNED_LONGS_EQUAL( 1000, LatencyHistogramGetPercentile(&histogram, 100) );
+}
+
+TEST(LatencyHistogram, PercentileDoesNotExceedMaximum) {
+  LatencyHistogramAdd(&histogram, 0);
+  LatencyHistogramAdd(&histogram, 600);
+  UNSIGNED_LONGS_EQUAL( 0, LatencyHistogramGetPercentile(&histogram, 50) );
+  UNSIGNED_LONGS_EQUAL( 600, LatencyHistogramGetPercentile(&histogram, 100) );
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright (c) 2026, the OpENer contributors
+ * All rights reserved.
+ *
+ ******************************************************************************/
+
+#include <CppUTest/TestHarness.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+extern "C" {
+#include <messagebufferpool.h>
+}
+
+static size_t s_allocations = 0;
+static size_t s_deallocations = 0;
+
+static void *CountingCalloc(size_t number_of_elements,
+                            size_t size_of_element) {
+  s_allocations++;
+  return calloc(number_of_elements, size_of_element);
+}
+
+static void CountingFree(void *memory) {
+  s_deallocations++;
+  free(memory);
+}
+
+TEST_GROUP(MessageBufferPool) {
+  MessageBufferPool pool;
+
+  void setup() {
+    s_allocations = 0;
+    s_deallocations = 0;
+    MessageBufferPoolInitialize(&pool, CountingCalloc, CountingFree);
+  }
+
+  void teardown() {
+    MessageBufferPoolDestroy(&pool);
+    CHECK_EQUAL(s_allocations, s_deallocations);
+  }
+};
+
+TEST(MessageBufferPool, CapacityIsSmallestFittingSizeClass) {
+  CHECK_EQUAL(64, MessageBufferPoolAcquire(&pool, 0)->capacity);
+  CHECK_EQUAL(64, MessageBufferPoolAcquire(&pool, 64)->capacity);
+  CHECK_EQUAL(128, MessageBufferPoolAcquire(&pool, 65)->capacity);
+  CHECK_EQUAL(4096, MessageBufferPoolAcquire(&pool, 4000)->capacity);
+  CHECK_EQUAL(65536, MessageBufferPoolAcquire(&pool, 65535)->capacity);
+}
+
+TEST(MessageBufferPool, TooLargeSizeIsRefused) {
+  POINTERS_EQUAL(NULL, MessageBufferPoolAcquire(&pool, 65537) );
+  CHECK_EQUAL(0, s_allocations);
+}
+
+TEST(MessageBufferPool, ReleasedBufferIsReused) {
+  MessageBuffer *const buffer = MessageBufferPoolAcquire(&pool, 500);
+  buffer->data[0] = 0x42;
+  MessageBufferPoolRelease(&pool, buffer);
+  MessageBuffer *const reused = MessageBufferPoolAcquire(&pool, 300);
+  POINTERS_EQUAL(buffer, reused);
+  CHECK_EQUAL(0x42, reused->data[0]);
+  CHECK_EQUAL(1, s_allocations);
+}
+
+TEST(MessageBufferPool, SizeClassesAreKeptApart) {
+  MessageBuffer *const small = MessageBufferPoolAcquire(&pool, 100);
+  MessageBufferPoolRelease(&pool, small);
+  MessageBuffer *const large = MessageBufferPoolAcquire(&pool, 1000);
+  CHECK(small != large);
+  POINTERS_EQUAL(small, MessageBufferPoolAcquire(&pool, 100) );
+  CHECK_EQUAL(2, s_allocations);
+  CHECK_EQUAL(128 + 1024, pool.allocated_capacity);
+}
+
+TEST(MessageBufferPool, BuffersInUseAreDistinct) {
+  MessageBuffer *const first = MessageBufferPoolAcquire(&pool, 100);
+  MessageBuffer *const second = MessageBufferPoolAcquire(&pool, 100);
+  CHECK(first != second);
+  MessageBufferPoolRelease(&pool, first);
+  MessageBufferPoolRelease(&pool, second);
+  CHECK(NULL != MessageBufferPoolAcquire(&pool, 100) );
+  CHECK(NULL != MessageBufferPoolAcquire(&pool, 100) );
+  CHECK_EQUAL(2, s_allocations);
+}
+
+TEST(MessageBufferPool, ReleasingNullIsIgnored) {
+  MessageBufferPoolRelease(&pool, NULL);
+  CHECK(NULL != MessageBufferPoolAcquire(&pool, 100) );
+}